@@ -0,0 +1,38 @@
+#pragma once
+
+#include <pl/helpers/types.hpp>
+
+#include <wolv/io/fs.hpp>
+
+#include <span>
+#include <vector>
+
+namespace pl::cli {
+
+    // Read-only view of a whole file. The file gets memory mapped where possible so large inputs don't have to be copied into memory up front
+    class MappedFile {
+    public:
+        explicit MappedFile(const std::fs::path &path);
+        ~MappedFile();
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        [[nodiscard]] bool isValid() const { return this->m_valid; }
+        [[nodiscard]] std::span<const u8> getData() const { return { this->m_data, this->m_size }; }
+        [[nodiscard]] size_t getSize() const { return this->m_size; }
+
+    private:
+        void unmap();
+
+        bool m_valid = false;
+        const u8 *m_data = nullptr;
+        size_t m_size = 0;
+
+        // Used instead of a mapping on platforms that don't support it
+        std::vector<u8> m_buffer;
+
+        void *m_mapping = nullptr;
+    };
+
+}
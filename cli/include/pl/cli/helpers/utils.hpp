@@ -1,6 +1,7 @@
 #pragma once
 
 #include <pl/pattern_language.hpp>
+#include <pl/cli/helpers/mapped_file.hpp>
 #include <wolv/io/file.hpp>
 
 #include <vector>
@@ -9,7 +10,7 @@ namespace pl::cli {
 
     void executePattern(
             PatternLanguage &runtime,
-            wolv::io::File &inputFilePath,
+            const MappedFile &inputFile,
             wolv::io::File &patternFilePath,
             const std::vector<std::fs::path> &includePaths,
             const std::vector<std::string> &defines,
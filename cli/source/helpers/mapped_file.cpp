@@ -0,0 +1,93 @@
+#include <pl/cli/helpers/mapped_file.hpp>
+
+#include <wolv/io/file.hpp>
+
+#if defined(OS_WINDOWS)
+    #include <windows.h>
+#elif !defined(OS_WEB)
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace pl::cli {
+
+    MappedFile::MappedFile(const std::fs::path &path) {
+        #if defined(OS_WINDOWS)
+            HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+            if (file != INVALID_HANDLE_VALUE) {
+                LARGE_INTEGER size;
+                if (GetFileSizeEx(file, &size) && size.QuadPart > 0) {
+                    HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+                    if (mapping != nullptr) {
+                        auto view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+                        if (view != nullptr) {
+                            this->m_mapping = mapping;
+                            this->m_data = static_cast<const u8*>(view);
+                            this->m_size = size_t(size.QuadPart);
+                            this->m_valid = true;
+                        } else {
+                            CloseHandle(mapping);
+                        }
+                    }
+                }
+
+                CloseHandle(file);
+
+                if (this->m_valid)
+                    return;
+            }
+        #elif !defined(OS_WEB)
+            int fd = ::open(path.c_str(), O_RDONLY);
+            if (fd >= 0) {
+                struct stat fileInfo = { };
+                if (::fstat(fd, &fileInfo) == 0 && fileInfo.st_size > 0) {
+                    auto mapping = ::mmap(nullptr, size_t(fileInfo.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+                    if (mapping != MAP_FAILED) {
+                        this->m_mapping = mapping;
+                        this->m_data = static_cast<const u8*>(mapping);
+                        this->m_size = size_t(fileInfo.st_size);
+                        this->m_valid = true;
+                    }
+                }
+
+                ::close(fd);
+
+                if (this->m_valid)
+                    return;
+            }
+        #endif
+
+        // Empty files, special files and platforms without mapping support get read into memory instead
+        wolv::io::File file(path, wolv::io::File::Mode::Read);
+        if (!file.isValid())
+            return;
+
+        this->m_buffer = file.readVector();
+        this->m_data = this->m_buffer.data();
+        this->m_size = this->m_buffer.size();
+        this->m_valid = true;
+    }
+
+    MappedFile::~MappedFile() {
+        this->unmap();
+    }
+
+    void MappedFile::unmap() {
+        if (this->m_mapping == nullptr)
+            return;
+
+        #if defined(OS_WINDOWS)
+            UnmapViewOfFile(this->m_data);
+            CloseHandle(static_cast<HANDLE>(this->m_mapping));
+        #elif !defined(OS_WEB)
+            ::munmap(this->m_mapping, this->m_size);
+        #endif
+
+        this->m_mapping = nullptr;
+        this->m_data = nullptr;
+        this->m_size = 0;
+    }
+
+}
@@ -28,7 +28,7 @@ namespace pl::cli {
 
     void executePattern(
             PatternLanguage &runtime,
-            wolv::io::File &inputFile,
+            const MappedFile &inputFile,
             wolv::io::File &patternFile,
             const std::vector<std::fs::path> &includePaths,
             const std::vector<std::string> &defines,
@@ -45,11 +45,7 @@ namespace pl::cli {
             runtime.addDefine(define);
 
         if (inputFile.isValid()) {
-            // Include baseAddress as a copy to prevent it from going out of scope in the lambda
-            runtime.setDataSource(baseAddress, inputFile.getSize(), [&inputFile, baseAddress](u64 address, void *buffer, size_t size) {
-                inputFile.seek(address - baseAddress);
-                inputFile.readBuffer(static_cast<u8*>(buffer), size);
-            });
+            runtime.setDataSource(baseAddress, inputFile.getData());
         } else {
             runtime.addPragma("example", [](pl::PatternLanguage &runtime, const std::string &value) {
                 auto data = parseByteString(value);
@@ -0,0 +1,374 @@
+#include <pl/pattern_language.hpp>
+#include <pl/formatters.hpp>
+#include <wolv/io/file.hpp>
+#include <wolv/utils/string.hpp>
+
+#include <pl/cli/helpers/mapped_file.hpp>
+
+#include <CLI/CLI.hpp>
+#include <CLI/App.hpp>
+#include <fmt/format.h>
+
+#include <nlohmann/json.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <set>
+#include <thread>
+
+namespace pl::cli::sub {
+
+    struct BatchResult {
+        int exitCode = EXIT_SUCCESS;
+        std::string error;
+        std::vector<u8> output;
+    };
+
+    struct InputFile {
+        std::fs::path path;
+        std::fs::path relativePath;
+    };
+
+    // Matches a file name against a simple wildcard pattern supporting '*' and '?'
+    static bool matchesFilter(std::string_view name, std::string_view filter) {
+        size_t nameIndex = 0, filterIndex = 0;
+        size_t starIndex = std::string_view::npos, matchIndex = 0;
+
+        while (nameIndex < name.size()) {
+            if (filterIndex < filter.size() && (filter[filterIndex] == '?' || filter[filterIndex] == name[nameIndex])) {
+                nameIndex += 1;
+                filterIndex += 1;
+            } else if (filterIndex < filter.size() && filter[filterIndex] == '*') {
+                starIndex = filterIndex;
+                matchIndex = nameIndex;
+                filterIndex += 1;
+            } else if (starIndex != std::string_view::npos) {
+                filterIndex = starIndex + 1;
+                matchIndex += 1;
+                nameIndex = matchIndex;
+            } else {
+                return false;
+            }
+        }
+
+        while (filterIndex < filter.size() && filter[filterIndex] == '*')
+            filterIndex += 1;
+
+        return filterIndex == filter.size();
+    }
+
+    // Collects all input files together with their path relative to the input directory they were found in
+    static std::vector<InputFile> collectInputFiles(const std::vector<std::fs::path> &inputPaths, const std::string &filter, bool recursive) {
+        std::vector<InputFile> result;
+
+        const auto addFile = [&](const std::fs::path &path, const std::fs::path &root) {
+            if (filter.empty() || matchesFilter(wolv::util::toUTF8String(path.filename()), filter))
+                result.push_back({ path, path.lexically_relative(root) });
+        };
+
+        for (const auto &inputPath : inputPaths) {
+            if (std::fs::is_directory(inputPath)) {
+                if (recursive) {
+                    for (const auto &entry : std::fs::recursive_directory_iterator(inputPath, std::fs::directory_options::skip_permission_denied)) {
+                        if (entry.is_regular_file())
+                            addFile(entry.path(), inputPath);
+                    }
+                } else {
+                    for (const auto &entry : std::fs::directory_iterator(inputPath)) {
+                        if (entry.is_regular_file())
+                            addFile(entry.path(), inputPath);
+                    }
+                }
+            } else if (std::fs::is_regular_file(inputPath)) {
+                result.push_back({ inputPath, inputPath.filename() });
+            }
+        }
+
+        return result;
+    }
+
+    static std::string getErrorMessage(const pl::PatternLanguage &runtime) {
+        if (const auto &compileErrors = runtime.getCompileErrors(); !compileErrors.empty()) {
+            std::string message;
+            for (const auto &error : compileErrors)
+                message += error.format();
+
+            return message;
+        }
+
+        if (const auto &error = runtime.getEvalError(); error.has_value())
+            return ::fmt::format("{}:{} -> {}", error->line, error->column, error->message);
+
+        return "Unknown error";
+    }
+
+    void addBatchSubcommand(CLI::App *app) {
+        static const auto formatters = pl::gen::fmt::createFormatters();
+
+        static std::vector<std::fs::path> inputPaths, includePaths;
+        static std::fs::path patternFilePath, outputPath;
+        static std::vector<std::string> defines;
+
+        static std::string formatterName, filter;
+        static bool verbose = false;
+        static bool allowDangerousFunctions = false;
+        static bool metaInformation = false;
+        static bool recursive = false;
+        static bool jsonLines = false;
+        static u64 baseAddress = 0x00;
+        static u32 threadCount = 0;
+
+        auto subcommand = app->add_subcommand("batch", "Executes the given pattern on many input files in parallel and outputs the pattern data of each of them in the wanted format");
+
+        // Add command line arguments
+        subcommand->add_option("-i,--inputs,INPUT_FILES", inputPaths, "Input files or directories to extract data from")->required()->take_all()->check(CLI::ExistingPath);
+        subcommand->add_option("-p,--pattern,PATTERN_FILE", patternFilePath, "Pattern file")->required()->check(CLI::ExistingFile);
+        subcommand->add_option("-o,--output", outputPath, "Directory to write one output file per input to. With --jsonl, the file to write the stream to instead of stdout");
+        subcommand->add_option("-I,--includes", includePaths, "Include file paths")->take_all()->check(CLI::ExistingDirectory);
+        subcommand->add_option("-D,--define", defines, "Define a preprocessor macro")->take_all();
+        subcommand->add_option("-b,--base", baseAddress, "Base address")->default_val(0x00);
+        subcommand->add_option("-t,--threads", threadCount, "Number of worker threads. Defaults to the number of hardware threads")->default_val(0);
+        subcommand->add_option("--filter", filter, "Only process files in input directories whose name matches this wildcard pattern, e.g. *.bin");
+        subcommand->add_flag("-r,--recursive", recursive, "Search input directories recursively")->default_val(false);
+        subcommand->add_flag("-j,--jsonl", jsonLines, "Write a single JSON-lines stream with one record per input instead of one file per input")->default_val(false);
+        subcommand->add_flag("-v,--verbose", verbose, "Verbose output")->default_val(false);
+        subcommand->add_flag("-d,--dangerous", allowDangerousFunctions, "Allow dangerous functions")->default_val(false);
+        subcommand->add_flag("-m,--metadata", metaInformation, "Include meta type information")->default_val(false);
+        subcommand->add_option("-f,--formatter", formatterName, "Output file format")->default_val("default")->check([&](const auto &value) -> std::string {
+            // Validate if the selected formatter exists
+            if (std::any_of(formatters.begin(), formatters.end(), [&](const auto &formatter) { return formatter->getName() == value; }))
+                return "";
+            else {
+                std::vector<std::string> formatterNames;
+                for (const auto &formatter : formatters)
+                    formatterNames.push_back(formatter->getName());
+
+                return ::fmt::format("Invalid formatter. Valid formatters are: [{}]", ::fmt::join(formatterNames, ", "));
+            }
+        });
+
+        subcommand->callback([] {
+            // JSON-lines records embed the JSON formatter output
+            if (jsonLines)
+                formatterName = "json";
+            else if (formatterName == "default")
+                formatterName = formatters.front()->getName();
+
+            if (!jsonLines) {
+                if (outputPath.empty()) {
+                    ::fmt::print("An output directory is required unless --jsonl is used\n");
+                    std::exit(EXIT_FAILURE);
+                }
+
+                std::error_code errorCode;
+                std::fs::create_directories(outputPath, errorCode);
+                if (!std::fs::is_directory(outputPath)) {
+                    ::fmt::print("Failed to create output directory '{}'\n", wolv::util::toUTF8String(outputPath));
+                    std::exit(EXIT_FAILURE);
+                }
+            }
+
+            const auto inputFiles = collectInputFiles(inputPaths, filter, recursive);
+            if (inputFiles.empty()) {
+                ::fmt::print("No input files found\n");
+                std::exit(EXIT_FAILURE);
+            }
+
+            // Output files mirror the input directory structure, make sure no two inputs end up writing to the same file
+            if (!jsonLines) {
+                std::set<std::fs::path> relativePaths;
+                for (const auto &inputFile : inputFiles) {
+                    if (!relativePaths.insert(inputFile.relativePath.lexically_normal()).second) {
+                        ::fmt::print("Multiple inputs map to the same output file '{}'\n", wolv::util::toUTF8String(inputFile.relativePath));
+                        std::exit(EXIT_FAILURE);
+                    }
+                }
+            }
+
+            // Open pattern file
+            wolv::io::File patternFile(patternFilePath, wolv::io::File::Mode::Read);
+            if (!patternFile.isValid()) {
+                ::fmt::print("Failed to open file '{}'\n", wolv::util::toUTF8String(patternFilePath));
+                std::exit(EXIT_FAILURE);
+            }
+
+            // Create and configure the Pattern Language runtime that all worker runtimes are cloned from
+            pl::PatternLanguage runtime;
+            runtime.setDangerousFunctionCallHandler([] {
+                return allowDangerousFunctions;
+            });
+
+            runtime.addPragma("MIME", [](auto&, const auto&){ return true; });
+
+            for (const auto &define : defines)
+                runtime.addDefine(define);
+
+            runtime.setIncludePaths(includePaths);
+
+            runtime.setLogCallback([](auto level, const std::string &message) {
+                if (!verbose)
+                    return;
+
+                switch (level) {
+                    using enum pl::core::LogConsole::Level;
+
+                    case Debug:
+                        ::fmt::print(stderr, "[DEBUG] {}\n", message);
+                        break;
+                    case Info:
+                        ::fmt::print(stderr, "[INFO]  {}\n", message);
+                        break;
+                    case Warning:
+                        ::fmt::print(stderr, "[WARN]  {}\n", message);
+                        break;
+                    case Error:
+                        ::fmt::print(stderr, "[ERROR] {}\n", message);
+                        break;
+                }
+            });
+
+            // Compile the pattern once, it's shared by all workers
+            const auto compiledPattern = runtime.compile(patternFile.readString(), wolv::util::toUTF8String(patternFilePath));
+            if (!compiledPattern.has_value()) {
+                ::fmt::print("Compilation failed\n");
+                for (const auto &error : runtime.getCompileErrors()) {
+                    ::fmt::print("{}\n", error.format());
+                }
+                std::exit(EXIT_FAILURE);
+            }
+
+            if (threadCount == 0)
+                threadCount = std::max<u32>(std::thread::hardware_concurrency(), 1);
+            threadCount = std::min<u32>(threadCount, inputFiles.size());
+
+            // Open the JSON-lines stream
+            std::optional<wolv::io::File> jsonLinesOutput;
+            if (jsonLines && !outputPath.empty()) {
+                jsonLinesOutput.emplace(outputPath, wolv::io::File::Mode::Create);
+                if (!jsonLinesOutput->isValid()) {
+                    ::fmt::print("Failed to create output file: {}\n", wolv::util::toUTF8String(outputPath));
+                    std::exit(EXIT_FAILURE);
+                }
+            }
+
+            std::mutex outputMutex;
+            std::atomic<size_t> nextInput = 0;
+            std::atomic<size_t> failedCount = 0;
+            std::atomic<u64> processedBytes = 0;
+
+            const auto writeResult = [&](const InputFile &inputFile, const BatchResult &result, const std::string &extension) {
+                if (jsonLines) {
+                    nlohmann::json record;
+                    record["input"]    = wolv::util::toUTF8String(inputFile.path);
+                    record["exitCode"] = result.exitCode;
+
+                    if (result.exitCode != EXIT_SUCCESS) {
+                        record["error"] = result.error;
+                    } else {
+                        auto data = nlohmann::json::parse(result.output.begin(), result.output.end(), nullptr, false);
+                        if (data.is_discarded())
+                            record["data"] = std::string(result.output.begin(), result.output.end());
+                        else
+                            record["data"] = std::move(data);
+                    }
+
+                    const auto line = record.dump() + "\n";
+
+                    std::scoped_lock lock(outputMutex);
+                    if (jsonLinesOutput.has_value())
+                        jsonLinesOutput->writeVector(std::vector<u8>(line.begin(), line.end()));
+                    else
+                        std::fwrite(line.data(), 1, line.size(), stdout);
+                } else if (result.exitCode != EXIT_SUCCESS) {
+                    std::scoped_lock lock(outputMutex);
+                    ::fmt::print(stderr, "Failed to process '{}': {}\n", wolv::util::toUTF8String(inputFile.path), result.error);
+                } else {
+                    auto outputFilePath = outputPath / inputFile.relativePath;
+                    outputFilePath += "." + extension;
+
+                    std::error_code errorCode;
+                    std::fs::create_directories(outputFilePath.parent_path(), errorCode);
+
+                    wolv::io::File outputFile(outputFilePath, wolv::io::File::Mode::Create);
+                    if (!outputFile.isValid()) {
+                        std::scoped_lock lock(outputMutex);
+                        ::fmt::print(stderr, "Failed to create output file: {}\n", wolv::util::toUTF8String(outputFilePath));
+                        failedCount += 1;
+                        return;
+                    }
+
+                    outputFile.writeVector(result.output);
+                }
+            };
+
+            // Every worker gets its own runtime and formatter. Runtimes are cloned up front since cloning reads from the main runtime
+            std::vector<pl::PatternLanguage> workerRuntimes;
+            workerRuntimes.reserve(threadCount);
+            for (u32 i = 0; i < threadCount; i++)
+                workerRuntimes.emplace_back(runtime.cloneRuntime());
+
+            const auto startTime = std::chrono::steady_clock::now();
+
+            std::vector<std::thread> workers;
+            workers.reserve(threadCount);
+            for (u32 i = 0; i < threadCount; i++) {
+                workers.emplace_back([&, &workerRuntime = workerRuntimes[i]] {
+                    auto workerFormatters = pl::gen::fmt::createFormatters();
+                    const auto &formatter = *std::find_if(workerFormatters.begin(), workerFormatters.end(), [](const auto &formatter) {
+                        return formatter->getName() == formatterName;
+                    });
+                    formatter->enableMetaInformation(metaInformation);
+
+                    while (true) {
+                        const auto index = nextInput.fetch_add(1);
+                        if (index >= inputFiles.size())
+                            break;
+
+                        const auto &inputFile = inputFiles[index];
+                        BatchResult result;
+
+                        pl::cli::MappedFile file(inputFile.path);
+                        if (!file.isValid()) {
+                            result.exitCode = EXIT_FAILURE;
+                            result.error = "Failed to open file";
+                            failedCount += 1;
+
+                            writeResult(inputFile, result, formatter->getFileExtension());
+                            continue;
+                        }
+
+                        processedBytes += file.getSize();
+
+                        workerRuntime.setDataSource(baseAddress, file.getData());
+
+                        result.exitCode = workerRuntime.execute(*compiledPattern);
+                        if (result.exitCode != EXIT_SUCCESS) {
+                            result.error = getErrorMessage(workerRuntime);
+                            failedCount += 1;
+                        } else {
+                            result.output = formatter->format(workerRuntime);
+                        }
+
+                        writeResult(inputFile, result, formatter->getFileExtension());
+                    }
+                });
+            }
+
+            for (auto &worker : workers)
+                worker.join();
+
+            const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+            const auto succeededCount = inputFiles.size() - failedCount;
+
+            ::fmt::print(stderr, "Processed {} files ({} succeeded, {} failed) on {} threads in {:.3f}s: {:.1f} files/s, {:.2f} MiB/s\n",
+                inputFiles.size(), succeededCount, failedCount.load(), threadCount, elapsed,
+                elapsed > 0 ? double(inputFiles.size()) / elapsed : 0.0,
+                elapsed > 0 ? double(processedBytes) / (1024.0 * 1024.0) / elapsed : 0.0);
+
+            if (failedCount > 0)
+                std::exit(EXIT_FAILURE);
+        });
+    }
+
+}
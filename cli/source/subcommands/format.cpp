@@ -60,7 +60,7 @@ namespace pl::cli::sub {
                                                   });
 
             // Open input file
-            wolv::io::File inputFile(inputFilePath, wolv::io::File::Mode::Read);
+            pl::cli::MappedFile inputFile(inputFilePath);
             if (!inputFilePath.empty() && !inputFile.isValid()) {
                 ::fmt::print("Failed to open file '{}'\n", inputFilePath.string());
                 std::exit(EXIT_FAILURE);
@@ -2,6 +2,8 @@
 #include <pl/formatters.hpp>
 #include <wolv/io/file.hpp>
 
+#include <pl/cli/helpers/mapped_file.hpp>
+
 #include <CLI/CLI.hpp>
 #include <CLI/App.hpp>
 #include <fmt/format.h>
@@ -45,13 +47,8 @@ namespace pl::cli::sub {
 
             runtime.setIncludePaths(includePaths);
 
-            auto data = wolv::io::File(inputFilePath, wolv::io::File::Mode::Read).readVector();
-            runtime.setDataSource(baseAddress, data.size(), [&](u64 address, void *buffer, size_t size) {
-                if (address + size > data.size())
-                    std::memset(buffer, 0x00, size);
-                else
-                    std::memcpy(buffer, data.data() + address, size);
-            });
+            pl::cli::MappedFile inputFile(inputFilePath);
+            runtime.setDataSource(baseAddress, inputFile.getData());
 
             runtime.setLogCallback([](auto level, const std::string &message) {
                 if (!verbose)
@@ -20,10 +20,55 @@ namespace pl::core::ast {
     public:
         using FunctionResult = std::optional<Token::Literal>;
 
+        // Concrete type of a node, so nodes can be told apart without going through RTTI.
+        // Nodes of classes that aren't part of this library are Unknown
+        enum class Kind : u8 {
+            Unknown,
+            ArrayVariableDecl,
+            Attribute,
+            Bitfield,
+            BitfieldArrayVariableDecl,
+            BitfieldField,
+            BitfieldFieldSigned,
+            BitfieldFieldSizedType,
+            BuiltinType,
+            Cast,
+            CompoundStatement,
+            ConditionalStatement,
+            ControlFlowStatement,
+            Enum,
+            FunctionCall,
+            FunctionDefinition,
+            ImportedType,
+            Literal,
+            LValueAssignment,
+            MatchStatement,
+            MathematicalExpression,
+            MultiVariableDecl,
+            ParameterPack,
+            PointerVariableDecl,
+            RValue,
+            RValueAssignment,
+            ScopeResolution,
+            Struct,
+            TemplateParameter,
+            TernaryExpression,
+            TryCatchStatement,
+            TypeApplication,
+            TypeDecl,
+            TypeOperator,
+            Union,
+            VariableDecl,
+            WhileStatement
+        };
+
         constexpr ASTNode() = default;
+        constexpr explicit ASTNode(Kind kind) : m_kind(kind) { }
         constexpr virtual ~ASTNode() = default;
         constexpr ASTNode(const ASTNode &) = default;
 
+        [[nodiscard]] Kind getKind() const { return this->m_kind; }
+
         [[nodiscard]] const Location& getLocation() const;
         void setLocation(const Location &location);
 
@@ -41,6 +86,7 @@ namespace pl::core::ast {
 
         std::string m_docComment;
         bool m_document = false;
+        Kind m_kind = Kind::Unknown;
     };
 
 }
\ No newline at end of file
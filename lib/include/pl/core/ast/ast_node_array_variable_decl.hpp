@@ -4,6 +4,8 @@
 #include <pl/core/ast/ast_node_attribute.hpp>
 #include <pl/core/ast/ast_node_type_appilication.hpp>
 
+#include <pl/patterns/pattern_array_dynamic.hpp>
+
 namespace pl::core::ast {
 
     class ASTNodeTypeDecl;
@@ -48,8 +50,10 @@ namespace pl::core::ast {
         std::unique_ptr<ASTNode> m_placementOffset, m_placementSection;
         bool m_constant;
 
+        [[nodiscard]] bool hasStaticEntryLayout(Evaluator *evaluator) const;
         void createStaticArray(Evaluator *evaluator, std::shared_ptr<ptrn::Pattern> &resultPattern) const;
         void createDynamicArray(Evaluator *evaluator, std::shared_ptr<ptrn::Pattern> &resultPattern) const;
+        [[nodiscard]] ptrn::PatternArrayDynamic::EntryMaterializer createEntryMaterializer(Evaluator *evaluator) const;
     };
 
 }
\ No newline at end of file
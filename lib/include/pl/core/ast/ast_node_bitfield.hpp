@@ -16,7 +16,7 @@ namespace pl::core::ast {
             LeastToMostSignificant = 1,
         };
 
-        ASTNodeBitfield() = default;
+        ASTNodeBitfield() : ASTNode(Kind::Bitfield) { }
         ASTNodeBitfield(const ASTNodeBitfield &other);
 
         [[nodiscard]] std::unique_ptr<ASTNode> clone() const override {
@@ -28,6 +28,9 @@ namespace pl::core::ast {
         [[nodiscard]] virtual std::shared_ptr<ptrn::PatternBitfieldField> createBitfield(Evaluator *evaluator, u64 byteOffset, u8 bitOffset, u8 bitSize) const;
         void createPatterns(Evaluator *evaluator, std::vector<std::shared_ptr<ptrn::Pattern>> &resultPatterns) const override;
 
+    protected:
+        ASTNodeBitfieldField(Kind kind, std::string name, std::unique_ptr<ASTNode> &&size);
+
     private:
         std::string m_name;
         std::unique_ptr<ASTNode> m_size;
@@ -35,7 +38,8 @@ namespace pl::core::ast {
 
     class ASTNodeBitfieldFieldSigned : public ASTNodeBitfieldField {
     public:
-        using ASTNodeBitfieldField::ASTNodeBitfieldField;
+        ASTNodeBitfieldFieldSigned(std::string name, std::unique_ptr<ASTNode> &&size)
+            : ASTNodeBitfieldField(Kind::BitfieldFieldSigned, std::move(name), std::move(size)) { }
 
         [[nodiscard]] std::shared_ptr<ptrn::PatternBitfieldField> createBitfield(Evaluator *evaluator, u64 byteOffset, u8 bitOffset, u8 bitSize) const override;
     };
@@ -10,7 +10,7 @@ namespace pl::core::ast {
     public:
         explicit ASTNodeBuiltinType(Token::ValueType type);
         explicit ASTNodeBuiltinType(api::FunctionParameterCount parameterCount, api::TypeCallback callback)
-        : m_type(Token::ValueType::CustomType), m_parameterCount(parameterCount), m_customTypeCallback(std::move(callback)) {}
+        : ASTNode(Kind::BuiltinType), m_type(Token::ValueType::CustomType), m_parameterCount(parameterCount), m_customTypeCallback(std::move(callback)) {}
 
         [[nodiscard]] constexpr const Token::ValueType& getType() const {
             return this->m_type;
@@ -16,6 +16,10 @@ namespace pl::core::ast {
 
         [[nodiscard]] std::unique_ptr<ASTNode> evaluate(Evaluator *evaluator) const override;
 
+        [[nodiscard]] const std::unique_ptr<ASTNode> &getValue() const {
+            return this->m_value;
+        }
+
     private:
         std::unique_ptr<ASTNode> castValue(const Token::Literal &literal, Token::ValueType type, const std::shared_ptr<ptrn::Pattern> &typePattern, Evaluator *evaluator) const;
 
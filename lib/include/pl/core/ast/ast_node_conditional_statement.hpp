@@ -27,11 +27,21 @@ namespace pl::core::ast {
             return this->m_falseBody;
         }
 
+        // Marks the condition as constant. Both bodies are kept, the condition just isn't evaluated anymore
+        void setConstantCondition(bool value) {
+            this->m_constantCondition = value;
+        }
+
+        [[nodiscard]] std::optional<bool> getConstantCondition() const {
+            return this->m_constantCondition;
+        }
+
     private:
         [[nodiscard]] bool evaluateCondition(const std::unique_ptr<ASTNode> &condition, Evaluator *evaluator) const;
 
         std::unique_ptr<ASTNode> m_condition;
         std::vector<std::unique_ptr<ASTNode>> m_trueBody, m_falseBody;
+        std::optional<bool> m_constantCondition;
     };
 
 }
\ No newline at end of file
@@ -16,6 +16,10 @@ namespace pl::core::ast {
         void createPatterns(Evaluator *evaluator, std::vector<std::shared_ptr<ptrn::Pattern>> &resultPatterns) const override;
         FunctionResult execute(Evaluator *evaluator) const override;
 
+        [[nodiscard]] const std::unique_ptr<ASTNode> &getRValue() const {
+            return this->m_rvalue;
+        }
+
     private:
         ControlFlowStatement m_type;
         std::unique_ptr<ASTNode> m_rvalue;
@@ -6,6 +6,7 @@
 #include <pl/patterns/pattern_enum.hpp>
 
 #include <map>
+#include <mutex>
 
 namespace pl::core::ast {
 
@@ -28,6 +29,7 @@ namespace pl::core::ast {
         void addEntry(const std::string &name, std::unique_ptr<ASTNode> &&minExpr, std::unique_ptr<ASTNode> &&maxExpr) {
             this->m_entries[name] = { std::move(minExpr), std::move(maxExpr) };
 
+            std::scoped_lock lock(this->m_cacheMutex);
             this->m_cachedEnumValues.clear();
         }
 
@@ -38,6 +40,7 @@ namespace pl::core::ast {
         std::unique_ptr<ASTNode> m_underlyingType;
 
         mutable std::map<std::string, ptrn::PatternEnum::EnumValue> m_cachedEnumValues;
+        mutable std::recursive_mutex m_cacheMutex;
     };
 
 }
\ No newline at end of file
@@ -2,6 +2,8 @@
 
 #include <pl/core/ast/ast_node.hpp>
 
+#include <atomic>
+
 namespace pl::core::ast {
 
     class ASTNodeFunctionCall : public ASTNode {
@@ -22,6 +24,11 @@ namespace pl::core::ast {
             return this->m_params;
         }
 
+        // Unique to this node and never reused, even by copies or nodes allocated at the same address later on
+        [[nodiscard]] u64 getCallSiteId() const {
+            return this->m_callSiteId;
+        }
+
         void createPatterns(Evaluator *evaluator, std::vector<std::shared_ptr<ptrn::Pattern>> &resultPatterns) const override;
         [[nodiscard]] std::unique_ptr<ASTNode> evaluate(Evaluator *evaluator) const override;
         FunctionResult execute(Evaluator *evaluator) const override;
@@ -29,6 +36,9 @@ namespace pl::core::ast {
     private:
         std::string m_functionName;
         std::vector<std::unique_ptr<ASTNode>> m_params;
+        u64 m_callSiteId = s_nextCallSiteId++;
+
+        static inline std::atomic<u64> s_nextCallSiteId = 0;
     };
 
 }
\ No newline at end of file
@@ -45,6 +45,14 @@ namespace pl::core::ast {
         void createPatterns(Evaluator *evaluator, std::vector<std::shared_ptr<ptrn::Pattern>> &resultPatterns) const override;
         FunctionResult execute(Evaluator *evaluator) const override;
 
+        [[nodiscard]] const std::vector<MatchCase> &getCases() const {
+            return this->m_cases;
+        }
+
+        [[nodiscard]] const std::optional<MatchCase> &getDefaultCase() const {
+            return this->m_defaultCase;
+        }
+
     private:
         [[nodiscard]] bool evaluateCondition(const std::unique_ptr<ASTNode> &condition, Evaluator *evaluator) const;
         [[nodiscard]] const std::vector<std::unique_ptr<ASTNode>>* getCaseBody(Evaluator *evaluator) const;
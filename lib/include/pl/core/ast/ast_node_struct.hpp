@@ -8,7 +8,7 @@ namespace pl::core::ast {
     class ASTNodeStruct : public ASTNode,
                           public Attributable {
     public:
-        ASTNodeStruct() = default;
+        ASTNodeStruct() : ASTNode(Kind::Struct) { }
         ASTNodeStruct(const ASTNodeStruct &other);
 
         [[nodiscard]] std::unique_ptr<ASTNode> clone() const override {
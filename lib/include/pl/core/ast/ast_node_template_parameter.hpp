@@ -7,7 +7,7 @@ namespace pl::core::ast {
     class ASTNodeTemplateParameter : public ASTNode {
     public:
         explicit ASTNodeTemplateParameter(Token::Identifier name, bool isType)
-            : m_name(std::move(name)), m_isType(isType) {}
+            : ASTNode(Kind::TemplateParameter), m_name(std::move(name)), m_isType(isType) {}
 
         ASTNodeTemplateParameter(const ASTNodeTemplateParameter &) = default;
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <pl/core/ast/ast_node.hpp>
+#include <pl/core/bytecode.hpp>
 
 namespace pl::core::ast {
 
@@ -20,9 +21,17 @@ namespace pl::core::ast {
         [[nodiscard]] const std::unique_ptr<ASTNode> &getThirdOperand() const { return this->m_third; }
         [[nodiscard]] Token::Operator getOperator() const { return this->m_operator; }
 
+        void setConstantValue(Token::Literal value) { this->m_constantValue = std::move(value); }
+        [[nodiscard]] const std::optional<Token::Literal> &getConstantValue() const { return this->m_constantValue; }
+
     private:
         std::unique_ptr<ASTNode> m_first, m_second, m_third;
         Token::Operator m_operator;
+
+        bytecode::CompiledExpression m_compiled;
+
+        // Set by the optimizer if the expression only depends on literals
+        std::optional<Token::Literal> m_constantValue;
     };
 
 }
\ No newline at end of file
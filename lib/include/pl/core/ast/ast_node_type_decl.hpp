@@ -8,10 +8,21 @@
 #include <wolv/utils/guards.hpp>
 
 #include <bit>
+#include <optional>
 
 namespace pl::core::ast {
 
-    class ASTNodeTypeApplication;
+    // Layout of a type that covers the same amount of data no matter where it's placed. Computed by the optimizer
+    struct StaticLayout {
+        struct Member {
+            std::string name;
+            u64 offset;
+            u64 size;
+        };
+
+        u64 size = 0;
+        std::vector<Member> members;
+    };
 
     class ASTNodeTypeDecl : public ASTNode,
                             public Attributable {
@@ -66,17 +77,25 @@ namespace pl::core::ast {
 
         const ASTNode* getTypeDefinition(Evaluator *evaluator) const;
 
+        void setStaticLayout(StaticLayout layout) {
+            this->m_staticLayout = std::move(layout);
+        }
+
+        [[nodiscard]] const std::optional<StaticLayout> &getStaticLayout() const {
+            return this->m_staticLayout;
+        }
+
     private:
         bool m_forwardDeclared = false;
         bool m_completed = false;
-        mutable bool m_alreadyCopied = false;
 
         std::string m_name;
         std::shared_ptr<ASTNode> m_type;
         std::vector<std::shared_ptr<ASTNodeTemplateParameter>> m_templateParameters;
         std::vector<std::unique_ptr<ASTNode>> m_templateArguments;
 
-        mutable std::unique_ptr<ASTNodeTypeApplication> m_currTemplateParameterType;
+        // Not copied on purpose. Instantiated layouts are cached by node address which is only stable for the original tree
+        std::optional<StaticLayout> m_staticLayout;
     };
 
 }
\ No newline at end of file
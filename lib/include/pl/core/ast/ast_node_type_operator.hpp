@@ -22,6 +22,14 @@ namespace pl::core::ast {
             return this->m_expression;
         }
 
+        void setConstantValue(Token::Literal value) {
+            this->m_constantValue = std::move(value);
+        }
+
+        [[nodiscard]] const std::optional<Token::Literal> &getConstantValue() const {
+            return this->m_constantValue;
+        }
+
         [[nodiscard]] std::unique_ptr<ASTNode> evaluate(Evaluator *evaluator) const override;
 
     private:
@@ -29,6 +37,9 @@ namespace pl::core::ast {
         std::unique_ptr<ASTNode> m_expression;
 
         bool m_providerOperation = false;
+
+        // Set by the optimizer for sizeof operations on types whose size doesn't depend on the data
+        std::optional<Token::Literal> m_constantValue;
     };
 
 }
\ No newline at end of file
@@ -8,7 +8,7 @@ namespace pl::core::ast {
     class ASTNodeUnion : public ASTNode,
                          public Attributable {
     public:
-        ASTNodeUnion() = default;
+        ASTNodeUnion() : ASTNode(Kind::Union) { }
         ASTNodeUnion(const ASTNodeUnion &other);
 
         [[nodiscard]] std::unique_ptr<ASTNode> clone() const override {
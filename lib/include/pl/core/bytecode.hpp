@@ -0,0 +1,117 @@
+#pragma once
+
+#include <pl/helpers/types.hpp>
+#include <pl/core/token.hpp>
+#include <pl/helpers/string_interner.hpp>
+
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace pl::core {
+
+    class Evaluator;
+    namespace ast { class ASTNode; }
+
+}
+
+namespace pl::core::bytecode {
+
+    enum class ValueType : u8 {
+        Unsigned,
+        Signed,
+        Boolean,
+        Character
+    };
+
+    // Unboxed integral value. Signed values and characters are stored sign extended
+    struct Register {
+        ValueType type;
+        u128 bits;
+    };
+
+    enum class OpCode : u8 {
+        LoadConstant,   // destination = constants[operand]
+        LoadVariable,   // destination = value of variables[operand]
+        LoadOffset,     // destination = $
+        Move,           // destination = left
+        ToBoolean,      // destination = bool(left)
+        Binary,         // destination = left <op> right
+        Jump,           // pc = operand
+        JumpIfFalse,    // if (!left) pc = operand
+        JumpIfTrue      // if (left) pc = operand
+    };
+
+    // Variable read by a program. Names are interned process wide when compiling since programs aren't tied to any one evaluator
+    struct Variable {
+        std::string name;
+        hlp::StringInterner::Id nameId;
+    };
+
+    struct Instruction {
+        OpCode opCode;
+        Token::Operator op;
+        u16 destination, left, right;
+        u32 operand;
+    };
+
+    /**
+     * @brief Integral expression lowered to instructions for a small register machine
+     * @note Programs only depend on the AST they were compiled from and can be shared between runtimes
+     */
+    class Program {
+    public:
+        constexpr static size_t MaxRegisterCount = 64;
+
+        /**
+         * @brief Compiles an expression tree
+         * @param expression Root of the expression
+         * @return Compiled program or nullptr if the expression uses anything the machine doesn't support
+         */
+        [[nodiscard]] static std::unique_ptr<Program> compile(const ast::ASTNode *expression);
+
+        /**
+         * @brief Executes the program
+         * @param evaluator Evaluator to read variables from
+         * @return Result of the expression or std::nullopt if the tree walking evaluator needs to take over.
+         *         Expressions don't have side effects so evaluating them again is always safe
+         */
+        [[nodiscard]] std::optional<Token::Literal> execute(Evaluator *evaluator) const;
+
+        [[nodiscard]] const std::vector<Instruction>& getInstructions() const { return this->m_instructions; }
+
+        /**
+         * @brief Checks if the program only operates on constants
+         * @return True if the program neither reads variables nor the current offset. Such programs can be executed without an evaluator
+         */
+        [[nodiscard]] bool isConstant() const;
+
+    private:
+        friend class Compiler;
+
+        std::vector<Instruction> m_instructions;
+        std::vector<Register> m_constants;
+        std::vector<Variable> m_variables;
+        u16 m_registerCount = 0;
+        u16 m_result = 0;
+    };
+
+    // Program of an AST node that gets compiled the first time the node is evaluated
+    class CompiledExpression {
+    public:
+        CompiledExpression() = default;
+
+        // Copies of an AST node compile their own program
+        CompiledExpression(const CompiledExpression &) : CompiledExpression() { }
+        CompiledExpression& operator=(const CompiledExpression &) = delete;
+
+        [[nodiscard]] std::optional<Token::Literal> execute(Evaluator *evaluator, const ast::ASTNode *expression) const;
+
+    private:
+        mutable std::once_flag m_compiled;
+        mutable std::unique_ptr<Program> m_program;
+    };
+
+}
@@ -8,12 +8,17 @@
 #include <vector>
 #include <memory>
 #include <set>
+#include <span>
+#include <tuple>
 #include <unordered_set>
 #include <unordered_map>
 
 #include <pl/core/log_console.hpp>
 #include <pl/core/token.hpp>
 #include <pl/api.hpp>
+#include <pl/helpers/arena.hpp>
+#include <pl/helpers/copy_on_write.hpp>
+#include <pl/helpers/string_interner.hpp>
 
 #include <pl/core/errors/runtime_errors.hpp>
 #include <pl/core/ast/ast_node_type_appilication.hpp>
@@ -32,6 +37,8 @@ namespace pl::ptrn {
     class PatternCreationLimiter;
     class PatternBitfieldField;
 
+    using AttributeMap = std::map<std::string, std::vector<core::Token::Literal>>;
+
 }
 
 namespace pl::core {
@@ -59,6 +66,21 @@ namespace pl::core {
 
         [[nodiscard]] bool evaluate(const std::vector<std::shared_ptr<ast::ASTNode>> &ast);
 
+        /**
+         * @brief Evaluates a program whose top-level statements have already been flattened
+         * @param ast Program the statements belong to
+         * @param statements Statements returned by flattenStatements for the same program
+         * @return True if evaluation succeeded
+         */
+        [[nodiscard]] bool evaluate(const std::vector<std::shared_ptr<ast::ASTNode>> &ast, const std::vector<ast::ASTNode*> &statements);
+
+        /**
+         * @brief Unpacks the compound statements of a program into the list of statements that get executed at the top level
+         * @param ast Program to flatten
+         * @return Statements in execution order, pointing into the AST
+         */
+        [[nodiscard]] static std::vector<ast::ASTNode*> flattenStatements(const std::vector<std::shared_ptr<ast::ASTNode>> &ast);
+
         [[nodiscard]] const auto &getPatterns() const {
             return this->m_patterns;
         }
@@ -67,6 +89,36 @@ namespace pl::core {
             this->m_patterns.push_back(std::move(pattern));
         }
 
+        /**
+         * @brief Creates a pattern in the evaluator's pattern arena
+         * @param args Constructor arguments following the evaluator
+         * @return Newly created pattern
+         */
+        template<typename T, typename ... Args>
+        [[nodiscard]] std::shared_ptr<T> createPattern(Args && ... args) {
+            return std::allocate_shared<T>(std::pmr::polymorphic_allocator<T>(&this->m_patternArena), this, std::forward<Args>(args)...);
+        }
+
+        [[nodiscard]] hlp::Arena &getPatternArena() {
+            return this->m_patternArena;
+        }
+
+        /**
+         * @brief Looks up the attributes of a declaration whose attribute arguments are all constant
+         * @param declaration Declaration the attributes belong to
+         * @return Attribute set shared by all patterns of the declaration or nullptr if it hasn't been evaluated yet
+         */
+        [[nodiscard]] const hlp::CopyOnWrite<ptrn::AttributeMap>* getConstantAttributes(const ast::ASTNode *declaration) const {
+            if (auto it = this->m_constantAttributes.find(declaration); it != this->m_constantAttributes.end())
+                return &it->second;
+            else
+                return nullptr;
+        }
+
+        void setConstantAttributes(const ast::ASTNode *declaration, hlp::CopyOnWrite<ptrn::AttributeMap> attributes) {
+            this->m_constantAttributes.insert_or_assign(declaration, std::move(attributes));
+        }
+
         [[nodiscard]] LogConsole &getConsole() {
             return this->m_console;
         }
@@ -88,6 +140,12 @@ namespace pl::core {
             std::vector<std::shared_ptr<ptrn::Pattern>> *scope;
             std::optional<ParameterPack> parameterPack;
             size_t heapStartSize;
+
+            // Index of the last variable with a given interned name. Built up lazily by Evaluator::findVariable()
+            std::unordered_map<hlp::StringInterner::Id, size_t> nameIndex;
+            std::vector<size_t> unnamedEntries;
+            size_t indexedEntries = 0;
+            u64 indexGeneration = 0;
         };
 
         struct PatternLocalData {
@@ -203,6 +261,7 @@ namespace pl::core {
         [[nodiscard]] std::map<std::string, Token::Literal> getOutVariables() const;
 
         void setDataSource(u64 baseAddress, size_t dataSize, std::function<void(u64, u8*, size_t)> readerFunction, std::optional<std::function<void(u64, const u8*, size_t)>> writerFunction = std::nullopt);
+        void setDataSource(u64 baseAddress, size_t dataSize, std::span<const u8> data, u64 dataAddress, std::optional<std::function<void(u64, const u8*, size_t)>> writerFunction = std::nullopt);
 
         void setDataBaseAddress(u64 baseAddress) {
             this->m_dataBaseAddress = baseAddress;
@@ -252,6 +311,20 @@ namespace pl::core {
             return this->m_arrayLimit;
         }
 
+        // Number of entries each lazy array keeps around at most. This counts entries, not bytes, so arrays of large entries use more memory
+        void setLazyEntryLimit(u64 limit) {
+            this->m_lazyEntryLimit = limit;
+        }
+
+        [[nodiscard]] u64 getLazyEntryLimit() const {
+            return this->m_lazyEntryLimit;
+        }
+
+        // Id of the current run. Lazy arrays only create their entries while the run they were created in is still the latest one
+        [[nodiscard]] u64 getEvaluationId() const {
+            return this->m_evaluationId;
+        }
+
         void setPatternLimit(u64 limit) {
             this->m_patternLimit = limit;
         }
@@ -312,6 +385,29 @@ namespace pl::core {
         }
 
         [[nodiscard]] std::optional<api::Function> findFunction(const std::string &name) const;
+        [[nodiscard]] const api::Function* getFunction(const std::string &name) const;
+        [[nodiscard]] const api::Function* getCallTarget(u64 callSiteId, const std::string &name);
+
+        /**
+         * @brief Checks if types with a static layout can currently be instantiated from their template
+         * @return False if the creation of patterns needs to be observable or depends on more than the read offset
+         */
+        [[nodiscard]] bool canUseLayoutTemplates() const;
+
+        /**
+         * @brief Creates a copy of the pattern that was created for a type with a static layout earlier during this evaluation
+         * @param type Type to instantiate
+         * @return Pattern placed at the current read offset or nullptr if the type hasn't been instantiated yet or can't be copied
+         */
+        [[nodiscard]] std::shared_ptr<ptrn::Pattern> instantiateLayoutTemplate(const ast::ASTNodeTypeDecl *type);
+
+        /**
+         * @brief Stores a copy of the first pattern created for a type with a static layout
+         * @param type Type the pattern was created for
+         * @param pattern Pattern to copy
+         * @param paletteIndex Index into the color palette from before the pattern was created
+         */
+        void setLayoutTemplate(const ast::ASTNodeTypeDecl *type, const std::shared_ptr<ptrn::Pattern> &pattern, u32 paletteIndex);
 
         [[nodiscard]] std::vector<std::vector<u8>> &getHeap() {
             return this->m_heap;
@@ -321,6 +417,14 @@ namespace pl::core {
             return this->m_heap;
         }
 
+        /**
+         * @brief Remembers the current state of the heap so it can be restored with popHeapCheckpoint()
+         * @note Only cells that get modified are copied. Code that modifies existing heap cells needs to call journalHeapCell() first
+         */
+        void pushHeapCheckpoint();
+        void popHeapCheckpoint();
+        void journalHeapCell(u64 heapAddress);
+
         [[nodiscard]] std::map<u32, PatternLocalData> &getPatternLocalStorage() {
             return this->m_patternLocalStorage;
         }
@@ -334,6 +438,11 @@ namespace pl::core {
         void createArrayVariable(const std::string &name, const ast::ASTNode *type, size_t entryCount, u64 section, bool constant = false);
         std::shared_ptr<ptrn::Pattern> createVariable(const std::string &name, const ast::ASTNodeTypeApplication *type, const std::optional<Token::Literal> &value = std::nullopt, bool outVariable = false, bool reference = false, bool templateVariable = false, bool constant = false);
         std::shared_ptr<ptrn::Pattern>& getVariableByName(const std::string &name);
+        [[nodiscard]] std::shared_ptr<ptrn::Pattern>* findVariable(Scope &scope, const std::string &name);
+        [[nodiscard]] std::shared_ptr<ptrn::Pattern>* findVariable(Scope &scope, hlp::StringInterner::Id id);
+        [[nodiscard]] std::shared_ptr<ptrn::Pattern>* findVariable(const std::string &name);
+        [[nodiscard]] std::shared_ptr<ptrn::Pattern>* findVariable(hlp::StringInterner::Id id);
+        void invalidateVariableLookups() { this->m_variableNameGeneration += 1; }
         void setVariable(const std::string &name, const Token::Literal &value);
         void setVariable(std::shared_ptr<ptrn::Pattern> &pattern, const Token::Literal &value);
         void setVariableAddress(const std::string &variableName, u64 address, u64 section = 0);
@@ -442,17 +551,19 @@ namespace pl::core {
             return this->m_lastPatternAddress;
         }
 
-        std::set<std::string>& getStringPool() {
-            return this->m_stringPool;
+        hlp::StringInterner& getStringInterner() {
+            return this->m_stringInterner;
         }
 
-        const std::set<std::string>& getStringPool() const {
-            return this->m_stringPool;
+        const hlp::StringInterner& getStringInterner() const {
+            return this->m_stringInterner;
         }
 
-        bool isStringPoolEntryValid(const std::set<std::string>::const_iterator &it) const {
-            return it != this->m_stringPool.end();
-        }
+        // Id of the pattern's name in this evaluator's interner, also for patterns that were created by other runtimes
+        [[nodiscard]] hlp::StringInterner::Id getVariableNameId(const ptrn::Pattern &pattern);
+
+        // Id in this evaluator's interner of a name that a compiled expression interned process wide. None if no variable has been given that name yet
+        [[nodiscard]] hlp::StringInterner::Id getProgramNameId(hlp::StringInterner::Id programNameId, const std::string &name);
 
         PatternLanguage& createSubRuntime() {
             return m_subRuntimes.emplace_back(this->m_patternLanguage->cloneRuntime());
@@ -474,6 +585,10 @@ namespace pl::core {
             m_patternColorPaletteIndex = 0;
         }
 
+        [[nodiscard]] u32 getPatternColorPaletteIndex() const {
+            return m_patternColorPaletteIndex;
+        }
+
         const std::set<ptrn::Pattern*>& getPatternsWithAttribute(const std::string &attribute) const {
             if (const auto it = m_attributedPatterns.find(attribute); it != m_attributedPatterns.end()) {
                 return it->second;
@@ -488,6 +603,11 @@ namespace pl::core {
         void patternDestroyed(ptrn::Pattern *pattern);
 
         api::FunctionCallback handleDangerousFunctionCall(const std::string &functionName, const api::FunctionCallback &function);
+        void assignPatternColors(ptrn::Pattern *pattern);
+        [[nodiscard]] static std::vector<u32> getPatternColors(ptrn::Pattern *pattern);
+
+        // Adds the variables that were added to the scope since its last lookup to its name index
+        void indexScope(Scope &scope);
 
         void setRuntime(PatternLanguage *runtime) {
             this->m_patternLanguage = runtime;
@@ -504,6 +624,9 @@ namespace pl::core {
         }
 
     private:
+        // Declared first so it outlives every member that holds on to patterns
+        hlp::Arena m_patternArena;
+
         PatternLanguage *m_patternLanguage = nullptr;
         std::list<PatternLanguage> m_subRuntimes;
 
@@ -519,6 +642,7 @@ namespace pl::core {
         std::endian m_defaultEndian = std::endian::native;
         u64 m_evalDepth = 0;
         u64 m_arrayLimit = 0;
+        u64 m_lazyEntryLimit = 0;
         u64 m_patternLimit = 0;
         u64 m_loopLimit = 0;
 
@@ -531,16 +655,33 @@ namespace pl::core {
         u64 m_sectionId = 0;
 
         std::vector<std::vector<u8>> m_heap;
+
+        struct HeapCheckpoint {
+            size_t heapSize;
+            std::map<u64, std::vector<u8>> savedCells;
+        };
+        std::vector<HeapCheckpoint> m_heapCheckpoints;
         std::map<u32, PatternLocalData> m_patternLocalStorage;
 
         std::map<std::string, std::set<ptrn::Pattern*>> m_attributedPatterns;
+        std::unordered_map<const ast::ASTNode*, hlp::CopyOnWrite<ptrn::AttributeMap>> m_constantAttributes;
         std::vector<std::unique_ptr<Scope>> m_scopes;
         std::vector<std::shared_ptr<ptrn::Pattern>> m_patterns;
 
         std::unordered_map <std::string, api::Function> m_customFunctions;
         std::unordered_map <std::string, api::Function> m_builtinFunctions;
+
+        // Functions resolved by each call site. Dropped whenever functions get added or removed
+        std::unordered_map<u64, const api::Function*> m_callTargets;
+        u64 m_functionGeneration = 0;
+        u64 m_callTargetGeneration = 0;
         std::vector<std::unique_ptr<ast::ASTNode>> m_customFunctionDefinitions;
 
+        // First instance of each type with a static layout per default endianness and section
+        std::map<std::tuple<const ast::ASTNodeTypeDecl*, std::endian, u64>, std::shared_ptr<ptrn::Pattern>> m_layoutTemplates;
+
+        u64 m_evaluationId = 0;
+
         std::optional<Token::Literal> m_mainResult;
 
         std::map<std::string, Token::Literal> m_envVariables;
@@ -557,7 +698,9 @@ namespace pl::core {
         ControlFlowStatement m_currControlFlowStatement = ControlFlowStatement::None;
         std::vector<StackTrace> m_callStack;
 
-        std::set<std::string> m_stringPool;
+        hlp::StringInterner m_stringInterner;
+        std::vector<hlp::StringInterner::Id> m_programNameIds;
+        u64 m_variableNameGeneration = 0;
 
         u64 m_dataBaseAddress = 0x00;
         u64 m_dataSize = 0x00;
@@ -568,6 +711,10 @@ namespace pl::core {
             err::E0011.throwError("No memory has been attached. Writing is disabled.");
         };
 
+        // Memory that main section reads are served from directly instead of going through the reader function
+        std::span<const u8> m_dataSpan;
+        u64 m_dataSpanAddress = 0x00;
+
         bool m_mainSectionEditsAllowed = false;
 
         std::optional<u64> m_currArrayIndex;
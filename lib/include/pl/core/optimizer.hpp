@@ -0,0 +1,106 @@
+#pragma once
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include <pl/helpers/types.hpp>
+#include <pl/core/token.hpp>
+
+namespace pl::core {
+
+    namespace ast { class ASTNode; class ASTNodeTypeDecl; class Attributable; struct StaticLayout; }
+
+    /**
+     * @brief Pass over a validated AST that precomputes everything that doesn't depend on the data being parsed
+     * @note Nodes are annotated in place instead of being replaced so the tree keeps its original shape for tooling
+     */
+    class Optimizer {
+    public:
+        struct Statistics {
+            u32 foldedExpressions = 0;
+            u32 prunedBranches = 0;
+            u32 staticSizes = 0;
+            u32 staticLayouts = 0;
+        };
+
+        Optimizer() = default;
+
+        void optimize(const std::vector<std::shared_ptr<ast::ASTNode>> &ast);
+
+        /**
+         * @brief Enables recording a description of every change the optimizer made
+         * @param enabled Whether to record changes
+         */
+        void setDebugOutputEnabled(bool enabled) {
+            this->m_debugOutputEnabled = enabled;
+        }
+
+        [[nodiscard]] const std::vector<std::string> &getDebugOutput() const {
+            return this->m_debugOutput;
+        }
+
+        /**
+         * @brief Returns problems the optimizer found in the code that don't prevent it from running
+         * @return List of warnings
+         */
+        [[nodiscard]] const std::vector<std::string> &getWarnings() const {
+            return this->m_warnings;
+        }
+
+        [[nodiscard]] const Statistics &getStatistics() const {
+            return this->m_statistics;
+        }
+
+    private:
+        void optimizeNodes(const std::vector<std::shared_ptr<ast::ASTNode>> &nodes);
+        void optimizeNodes(const std::vector<std::unique_ptr<ast::ASTNode>> &nodes);
+        void optimizeNode(ast::ASTNode *node);
+
+        void foldExpression(ast::ASTNode *node);
+        void pruneConditional(ast::ASTNode *node);
+        void computeStaticSize(ast::ASTNode *node);
+        void checkStaticHint(const ast::ASTNodeTypeDecl *typeDecl);
+
+        struct DataDependency {
+            const ast::ASTNode *node;
+            std::string description;
+        };
+
+        /**
+         * @brief Searches a type for the first construct that makes its layout depend on the data
+         * @param node Type or member to search
+         * @return The construct and a description of it or std::nullopt if the layout only looks dynamic to the optimizer
+         */
+        [[nodiscard]] std::optional<DataDependency> findDataDependency(ast::ASTNode *node);
+
+        [[nodiscard]] static std::optional<Token::Literal> getConstantValue(const ast::ASTNode *node);
+        [[nodiscard]] static bool hasStaticAttributes(const ast::Attributable &attributable);
+
+        /**
+         * @brief Computes the layout of a type declaration and stores it in the declaration
+         * @param typeDecl Type to analyze
+         * @return Layout of the type or nullptr if the type's layout depends on the data
+         */
+        const ast::StaticLayout* analyzeLayout(ast::ASTNodeTypeDecl *typeDecl);
+        [[nodiscard]] std::optional<u64> getStaticSize(ast::ASTNode *type);
+        [[nodiscard]] bool addStaticMember(ast::ASTNode *member, ast::StaticLayout &layout);
+
+        void addDebugOutput(const ast::ASTNode *node, const std::string &message);
+        void addWarning(const ast::ASTNode *node, const std::string &message);
+
+        constexpr static u32 MaxTypeDepth = 32;
+
+        bool m_debugOutputEnabled = false;
+        u32 m_typeDepth = 0;
+
+        std::unordered_set<const ast::ASTNode*> m_visitedTypes;
+        std::unordered_set<const ast::ASTNode*> m_dynamicLayoutTypes;
+        std::vector<std::string> m_debugOutput;
+        std::vector<std::string> m_warnings;
+        Statistics m_statistics;
+    };
+
+}
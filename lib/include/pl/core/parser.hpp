@@ -42,6 +42,7 @@ namespace pl::core {
         void reset();
 
         const auto &getTypes() { return this->m_types; }
+        auto extractTypes() { return std::exchange(this->m_types, { }); }
 
         [[nodiscard]] const std::vector<std::string>& getGlobalDocComments() const {
             return this->m_globalDocComments;
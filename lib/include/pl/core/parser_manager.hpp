@@ -70,6 +70,10 @@ namespace pl::core {
             return m_builtinTypes;
         }
 
+        auto extractParsedTypes() {
+            return std::exchange(this->m_parsedTypes, { });
+        }
+
 private:
         std::map<OnceIncludePair, std::map<std::string, hlp::safe_shared_ptr<ast::ASTNodeTypeDecl>>> m_parsedTypes;
         std::map<std::string, hlp::safe_shared_ptr<ast::ASTNodeTypeDecl>> m_builtinTypes;
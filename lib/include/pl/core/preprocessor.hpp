@@ -114,6 +114,10 @@ namespace pl::core {
             return m_onceIncludedFiles;
         }
 
+        const auto &getPragmas() const {
+            return m_pragmas;
+        }
+
         void appendToNamespaces(std::vector<Token> tokens);
         void saveTokens(api::Source *source, const std::vector<Token> &tokens);
         const std::map<std::string, std::vector<Token>> &getParsedImports() const {
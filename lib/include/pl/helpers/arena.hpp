@@ -0,0 +1,63 @@
+#pragma once
+
+#include <pl/helpers/types.hpp>
+
+#include <atomic>
+#include <memory_resource>
+
+namespace pl::hlp {
+
+    // Pool allocator for the objects of an evaluation run. Objects of the same size share a pool, so creating and
+    // freeing a whole tree only takes blocks from and hands them back to their pool instead of going through malloc.
+    // Objects are handed out as shared pointers and may be copied or released by any thread, so the pools are synchronized.
+    // Releasing the memory must not race with allocations though, which is why it only happens when a new run starts
+    class Arena : public std::pmr::memory_resource {
+    public:
+        struct Statistics {
+            std::atomic<u64> allocations = 0;
+            std::atomic<u64> liveAllocations = 0;
+            std::atomic<u64> releases = 0;
+        };
+
+        Arena() = default;
+        Arena(const Arena &) = delete;
+        Arena& operator=(const Arena &) = delete;
+
+        [[nodiscard]] const Statistics& getStatistics() const { return this->m_statistics; }
+
+        // Returns all memory of the pools to the system. Only possible once every object allocated from the arena is gone
+        bool releaseIfUnused() {
+            if (this->m_statistics.liveAllocations != 0)
+                return false;
+
+            this->m_pool.release();
+            this->m_statistics.releases++;
+
+            return true;
+        }
+
+    private:
+        void* do_allocate(size_t bytes, size_t alignment) override {
+            auto result = this->m_pool.allocate(bytes, alignment);
+
+            this->m_statistics.allocations++;
+            this->m_statistics.liveAllocations++;
+
+            return result;
+        }
+
+        void do_deallocate(void *pointer, size_t bytes, size_t alignment) override {
+            this->m_pool.deallocate(pointer, bytes, alignment);
+
+            this->m_statistics.liveAllocations--;
+        }
+
+        [[nodiscard]] bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override {
+            return this == &other;
+        }
+
+        std::pmr::synchronized_pool_resource m_pool;
+        Statistics m_statistics;
+    };
+
+}
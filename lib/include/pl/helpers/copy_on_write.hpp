@@ -0,0 +1,69 @@
+#pragma once
+
+#include <pl/helpers/types.hpp>
+
+#include <utility>
+
+namespace pl::hlp {
+
+    // Pointer sized handle to a reference counted value that is shared between copies of the handle until one of
+    // them modifies it. The count isn't atomic, all handles to the same value have to be used by the same thread
+    template<typename T>
+    class CopyOnWrite {
+    public:
+        CopyOnWrite() = default;
+        explicit CopyOnWrite(T value) : m_data(new Data { std::move(value), 1 }) { }
+
+        CopyOnWrite(const CopyOnWrite &other) : m_data(other.m_data) {
+            if (this->m_data != nullptr)
+                this->m_data->referenceCount++;
+        }
+
+        CopyOnWrite(CopyOnWrite &&other) noexcept : m_data(std::exchange(other.m_data, nullptr)) { }
+
+        CopyOnWrite& operator=(CopyOnWrite other) noexcept {
+            std::swap(this->m_data, other.m_data);
+            return *this;
+        }
+
+        ~CopyOnWrite() {
+            this->reset();
+        }
+
+        [[nodiscard]] const T* get() const {
+            return this->m_data == nullptr ? nullptr : &this->m_data->value;
+        }
+
+        [[nodiscard]] bool isShared() const {
+            return this->m_data != nullptr && this->m_data->referenceCount > 1;
+        }
+
+        // Returns a value only this handle refers to, copying the shared one first if needed
+        [[nodiscard]] T& modify() {
+            if (this->m_data == nullptr)
+                this->m_data = new Data { T(), 1 };
+            else if (this->isShared()) {
+                this->m_data->referenceCount--;
+                this->m_data = new Data { this->m_data->value, 1 };
+            }
+
+            return this->m_data->value;
+        }
+
+        void reset() {
+            if (this->m_data != nullptr && --this->m_data->referenceCount == 0)
+                delete this->m_data;
+
+            this->m_data = nullptr;
+        }
+
+    private:
+        struct Data {
+            T value;
+            u32 referenceCount;
+        };
+
+        Data *m_data = nullptr;
+    };
+
+}
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <pl/helpers/types.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+namespace pl::hlp {
+
+    // Least recently used cache of fixed size pages in front of a slow reader function
+    class PageCache {
+    public:
+        struct Statistics {
+            u64 hits = 0;
+            u64 misses = 0;
+        };
+
+        // A page count of zero disables the cache
+        void configure(size_t pageSize, size_t pageCount) {
+            this->m_pageSize  = std::max<size_t>(pageSize, 1);
+            this->m_pageCount = pageCount;
+
+            this->clear();
+        }
+
+        [[nodiscard]] bool isEnabled() const { return this->m_pageCount > 0; }
+        [[nodiscard]] size_t getPageSize() const { return this->m_pageSize; }
+        [[nodiscard]] size_t getPageCount() const { return this->m_pageCount; }
+
+        [[nodiscard]] const Statistics& getStatistics() const { return this->m_statistics; }
+        void resetStatistics() { this->m_statistics = { }; }
+
+        // Reads the range [address, address + size) of the data in [dataStart, dataEnd). Pages are aligned to dataStart and never reach past dataEnd
+        template<typename Reader>
+        void read(u64 address, u8 *buffer, size_t size, u64 dataStart, u64 dataEnd, const Reader &reader) {
+            const bool outsideOfData = address < dataStart || address >= dataEnd || size > dataEnd - address;
+            if (!this->isEnabled() || outsideOfData || size > this->m_pageSize * this->m_pageCount) {
+                reader(address, buffer, size);
+                return;
+            }
+
+            while (size > 0) {
+                const auto pageAddress = dataStart + ((address - dataStart) / this->m_pageSize) * this->m_pageSize;
+                const auto &page = this->getPage(pageAddress, dataEnd, reader);
+
+                const auto pageOffset = address - pageAddress;
+                const auto readSize = std::min<size_t>(size, page.size() - pageOffset);
+                std::memcpy(buffer, page.data() + pageOffset, readSize);
+
+                address += readSize;
+                buffer  += readSize;
+                size    -= readSize;
+            }
+        }
+
+        void invalidate(u64 address, size_t size) {
+            if (size == 0)
+                return;
+
+            const auto end = address + size - 1;
+            for (auto it = this->m_pages.begin(); it != this->m_pages.end();) {
+                const auto pageEnd = it->address + it->data.size() - 1;
+                if (it->address <= end && address <= pageEnd) {
+                    this->m_lookup.erase(it->address);
+                    it = this->m_pages.erase(it);
+                } else {
+                    ++it;
+                }
+            }
+        }
+
+        void clear() {
+            this->m_pages.clear();
+            this->m_lookup.clear();
+        }
+
+    private:
+        struct Page {
+            u64 address;
+            std::vector<u8> data;
+        };
+
+        template<typename Reader>
+        const std::vector<u8>& getPage(u64 pageAddress, u64 dataEnd, const Reader &reader) {
+            if (auto it = this->m_lookup.find(pageAddress); it != this->m_lookup.end()) {
+                this->m_statistics.hits += 1;
+
+                // Move the page to the front so it's the last one to be evicted
+                this->m_pages.splice(this->m_pages.begin(), this->m_pages, it->second);
+                return it->second->data;
+            }
+
+            this->m_statistics.misses += 1;
+
+            // Read the page before touching the cache so a failing reader doesn't leave a broken page behind
+            std::vector<u8> data(std::min<u64>(this->m_pageSize, dataEnd - pageAddress));
+            reader(pageAddress, data.data(), data.size());
+
+            if (this->m_pages.size() >= this->m_pageCount) {
+                this->m_lookup.erase(this->m_pages.back().address);
+                this->m_pages.pop_back();
+            }
+
+            auto &page = this->m_pages.emplace_front(Page { pageAddress, std::move(data) });
+            this->m_lookup.emplace(pageAddress, this->m_pages.begin());
+
+            return page.data;
+        }
+
+    private:
+        size_t m_pageSize = 0x1000;
+        size_t m_pageCount = 0;
+
+        std::list<Page> m_pages;
+        std::unordered_map<u64, std::list<Page>::iterator> m_lookup;
+
+        Statistics m_statistics;
+    };
+
+}
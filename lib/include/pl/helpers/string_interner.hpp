@@ -0,0 +1,66 @@
+#pragma once
+
+#include <pl/helpers/types.hpp>
+
+#include <deque>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace pl::hlp {
+
+    // Stores every distinct string once and hands out a 32 bit id for it, so equal strings can be compared by their id.
+    // Ids stay valid and views stay pointing to the same string until the interner is cleared
+    class StringInterner {
+    public:
+        using Id = u32;
+
+        // Id that doesn't belong to any string
+        constexpr static Id None = 0;
+
+        StringInterner() = default;
+        StringInterner(const StringInterner &) = delete;
+        StringInterner& operator=(const StringInterner &) = delete;
+
+        [[nodiscard]] Id intern(std::string_view string) {
+            if (auto it = this->m_ids.find(string); it != this->m_ids.end())
+                return it->second;
+
+            // The deque never moves its elements, so the view used as the key stays valid
+            const auto &stored = this->m_strings.emplace_back(string);
+            const auto id = Id(this->m_strings.size());
+            this->m_ids.emplace(stored, id);
+
+            return id;
+        }
+
+        // Returns the id of a string that has been interned before or None if there's none
+        [[nodiscard]] Id find(std::string_view string) const {
+            if (auto it = this->m_ids.find(string); it != this->m_ids.end())
+                return it->second;
+            else
+                return None;
+        }
+
+        [[nodiscard]] std::string_view get(Id id) const {
+            if (id == None || id > this->m_strings.size())
+                return { };
+
+            return this->m_strings[id - 1];
+        }
+
+        [[nodiscard]] size_t size() const {
+            return this->m_strings.size();
+        }
+
+        void clear() {
+            this->m_ids.clear();
+            this->m_strings.clear();
+        }
+
+    private:
+        std::deque<std::string> m_strings;
+        std::unordered_map<std::string_view, Id> m_ids;
+    };
+
+}
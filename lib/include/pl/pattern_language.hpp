@@ -8,7 +8,9 @@
 #include <vector>
 #include <filesystem>
 #include <set>
+#include <span>
 #include <thread>
+#include <unordered_map>
 
 #include <pl/api.hpp>
 
@@ -20,6 +22,7 @@
 #include <pl/core/parser_manager.hpp>
 
 #include <pl/helpers/types.hpp>
+#include <pl/helpers/page_cache.hpp>
 
 #include <wolv/io/fs.hpp>
 #include <wolv/container/interval_tree.hpp>
@@ -31,6 +34,7 @@ namespace pl {
         class Lexer;
         class Parser;
         class Validator;
+        class Optimizer;
         class Evaluator;
 
         namespace ast { class ASTNode; }
@@ -38,13 +42,53 @@ namespace pl {
 
     namespace ptrn {
         class Pattern;
+        class PatternArrayStatic;
         class IIterable;
     }
 
+    /**
+     * @brief A pattern that has been preprocessed, parsed and validated once and can be executed many times
+     * @note Obtained from PatternLanguage#compile() and executed through PatternLanguage#execute(). Copies are cheap and share the same program
+     * @note The compiled pattern keeps its AST, the types it resolved and the built-in functions that were registered when it was compiled alive
+     * @note A compiled pattern is immutable and may be executed by multiple runtimes on different threads at the same time. Use PatternLanguage#cloneRuntime() to create one runtime per thread.
+     *   The runtime it was compiled with needs to outlive it since error locations refer to that runtime's sources
+     */
+    class CompiledPattern {
+    public:
+        CompiledPattern() = default;
+
+        /**
+         * @brief Checks whether this handle refers to a compiled program
+         * @return True if the pattern can be executed, false otherwise
+         */
+        [[nodiscard]] bool isValid() const {
+            return this->m_data != nullptr;
+        }
+
+        /**
+         * @brief Gets the validated AST of the compiled program
+         * @return AST
+         */
+        [[nodiscard]] const std::vector<std::shared_ptr<core::ast::ASTNode>>& getAST() const;
+
+        /**
+         * @brief Gets the name of the source the program was compiled from
+         * @return Source name
+         */
+        [[nodiscard]] const std::string& getSource() const;
+
+    private:
+        friend class PatternLanguage;
+
+        struct Data;
+        std::shared_ptr<const Data> m_data;
+    };
+
     /**
      * @brief This is the main entry point for the Pattern Language
      * @note The runtime can be reused for multiple executions, but if you want to execute multiple files at once, you should create a new runtime for each file
      * @note Things like the abort function and getter functions to check if the runtime is currently executing code are thread safe. However, the runtime is not thread safe in general
+     * @note To evaluate one pattern on multiple threads, compile it once using PatternLanguage#compile() and execute the CompiledPattern on a separate runtime per thread
      */
     class PatternLanguage {
     public:
@@ -64,6 +108,7 @@ namespace pl {
             std::unique_ptr<core::Lexer>        lexer;
             std::unique_ptr<core::Parser>       parser;
             std::unique_ptr<core::Validator>    validator;
+            std::unique_ptr<core::Optimizer>    optimizer;
             std::unique_ptr<core::Evaluator>    evaluator;
         };
 
@@ -95,6 +140,26 @@ namespace pl {
          */
         [[nodiscard]] int executeString(const std::string& code, const std::string& source = api::Source::DefaultSource, const std::map<std::string, core::Token::Literal> &envVars = {}, const std::map<std::string, core::Token::Literal> &inVariables = {}, bool checkResult = true);
 
+        /**
+         * @brief Preprocesses, parses and validates a pattern language code string without executing it
+         *   To get compilation errors, check PatternLanguage#getCompileErrors() after calling this method
+         * @param code Code to compile
+         * @param source Source of the code
+         * @return Compiled pattern that can be passed to PatternLanguage#execute() any number of times, std::nullopt if compilation failed
+         */
+        [[nodiscard]] std::optional<CompiledPattern> compile(const std::string &code, const std::string &source = api::Source::DefaultSource);
+
+        /**
+         * @brief Executes a previously compiled pattern against the current data source
+         * @note Pragmas of the compiled pattern are applied again before every execution
+         * @param pattern Pattern to execute
+         * @param envVars List of environment variables to set
+         * @param inVariables List of input variables
+         * @param checkResult Whether to check the result of the execution
+         * @return 0 if the execution was successful, result returned from the runtime otherwise. Call PatternLanguage#getEvalError() to get the runtime error if non-zero is returned
+         */
+        [[nodiscard]] int execute(const CompiledPattern &pattern, const std::map<std::string, core::Token::Literal> &envVars = {}, const std::map<std::string, core::Token::Literal> &inVariables = {}, bool checkResult = true);
+
         /**
          * @brief Executes a pattern language file
          * @param path Path to the file to execute
@@ -143,6 +208,39 @@ namespace pl {
          */
         void setDataSource(u64 baseAddress, u64 size, std::function<void(u64, u8*, size_t)> readFunction, std::optional<std::function<void(u64, const u8*, size_t)>> writerFunction = std::nullopt);
 
+        /**
+         * @brief Sets a block of memory as the data source for the pattern language
+         * @note Reads are copied straight out of the given memory without going through a callback. Reads outside of it return zeros.
+         *       The memory is not copied and has to stay valid for as long as the runtime may access it
+         * @param baseAddress Address of the first byte of the memory
+         * @param data Memory to read from
+         * @param writerFunction Optional function to write data to the data source
+         */
+        void setDataSource(u64 baseAddress, std::span<const u8> data, std::optional<std::function<void(u64, const u8*, size_t)>> writerFunction = std::nullopt);
+
+        /**
+         * @brief Configures the page cache that sits in between the evaluator and the read function of the data source
+         * @note Useful for slow data sources where every call of the read function is expensive. Memory data sources don't use the cache
+         * @param pageSize Number of bytes read from the data source at once
+         * @param pageCount Maximum number of pages kept in memory. Zero disables the cache
+         */
+        void setDataCache(size_t pageSize, size_t pageCount);
+
+        /**
+         * @brief Drops all cached data of the given range. Needs to be called whenever the data source changed outside of the runtime
+         * @param address Start address of the range
+         * @param size Size of the range
+         */
+        void invalidateDataRange(u64 address, size_t size);
+
+        /**
+         * @brief Gets the number of page hits and misses of the data cache
+         * @return Cache statistics
+         */
+        [[nodiscard]] const hlp::PageCache::Statistics& getDataCacheStatistics() const {
+            return this->m_dataCache.getStatistics();
+        }
+
         /**
          * @brief Sets the base address of the data source
          * @param baseAddress Base address of the data source
@@ -267,6 +365,8 @@ namespace pl {
 
         /**
          * @brief Gets all patterns that were created in the given section
+         * @note Patterns are allocated by the runtime that created them. Their memory may be freed from any thread, but reading,
+         *       copying or releasing them must not overlap with a run of that runtime, since that uses the same evaluator
          * @param section Section Id
          * @return All patterns in the given section
          */
@@ -289,6 +389,41 @@ namespace pl {
          */
         [[nodiscard]] std::vector<u32> getColorsAtAddress(u64 address, u64 section = 0x00) const;
 
+        /**
+         * @brief Range of consecutive addresses that are all highlighted with the same colors
+         */
+        struct ColorRun {
+            u64 start, end;
+            std::vector<u32> colors;
+        };
+
+        /**
+         * @brief Address range covered by a single pattern
+         * @note Entries of static arrays all share the same pattern object. Use getPatternsAtAddress() to move it to a specific entry before reading its value
+         */
+        struct PatternSpan {
+            u64 start, end;
+            ptrn::Pattern *pattern;
+        };
+
+        /**
+         * @brief Gets the colors of all addresses in the given range in a single query
+         * @param start First address of the range
+         * @param end Last address of the range
+         * @param section Section id
+         * @return Runs of addresses with the same colors, covering the whole range in ascending order. Addresses without any highlighting have an empty color list
+         */
+        [[nodiscard]] std::vector<ColorRun> getColorsInRange(u64 start, u64 end, u64 section = 0x00) const;
+
+        /**
+         * @brief Gets all patterns that overlap with the given range in a single query
+         * @param start First address of the range
+         * @param end Last address of the range
+         * @param section Section id
+         * @return Spans of all overlapping patterns, sorted by start address. Every span is only returned once
+         */
+        [[nodiscard]] std::vector<PatternSpan> getPatternsInRange(u64 start, u64 end, u64 section = 0x00) const;
+
         /**
          * @brief Resets the runtime
          */
@@ -337,6 +472,14 @@ namespace pl {
          */
         void addType(const api::Namespace &ns, const std::string &name, api::FunctionParameterCount parameterCount, const api::TypeCallback &func);
 
+        struct Function {
+            api::Namespace nameSpace;
+            std::string name;
+            api::FunctionParameterCount parameterCount;
+            api::FunctionCallback callback;
+            bool dangerous;
+        };
+
         /**
          * @brief Gets the internals of the pattern language
          * @warning Generally this should only be used by "IDEs" or other tools that need to access the internals of the pattern language
@@ -391,6 +534,16 @@ namespace pl {
             return this->m_patternsValid;
         }
 
+        /**
+         * @brief Checks whether the lookup structures used by getPatternsAtAddress() and getColorsAtAddress() have been built
+         * @note The intervals of all patterns are collected before an execution returns since that creates patterns through the evaluator.
+         *       Only building the lookup structures from them happens in the background. Querying them before that finished blocks until they're ready
+         * @return True if the patterns have been flattened, false otherwise
+         */
+        [[nodiscard]] bool arePatternsFlattened() const {
+            return this->m_flattenedPatternsValid;
+        }
+
         /**
          * @brief Gets the current run id
          * @return Run id
@@ -412,7 +565,36 @@ namespace pl {
         [[nodiscard]] const std::set<pl::ptrn::Pattern*>& getPatternsWithAttribute(const std::string &attribute) const;
 
     private:
+        int executeImpl(const std::function<bool()> &prepare, const std::vector<Function> &functions, const std::map<std::string, core::Token::Literal> &envVars, const std::map<std::string, core::Token::Literal> &inVariables, bool checkResult);
+        void registerBuiltinFunctions(const std::vector<Function> &functions);
+        struct FlattenedInterval {
+            u64 start, end;
+            ptrn::Pattern *pattern;
+        };
+
+        using PatternIntervalTree = wolv::container::IntervalTree<ptrn::Pattern*, u64, 8>;
+
+        // Interval trees of a section, split up by address so they can be built in parallel
+        struct FlattenedSection {
+            std::vector<u64> shardStarts;
+            std::vector<PatternIntervalTree> shards;
+        };
+
+        // Static or compact array that is highlighted by repeating the children of its template every stride bytes instead of storing every entry
+        struct StridedHighlight {
+            ptrn::Pattern *templateRoot;
+            u64 stride, count;
+            PatternIntervalTree children;
+        };
+
+        static FlattenedSection buildFlattenedSection(std::vector<FlattenedInterval> &intervals, const std::atomic<bool> &aborted);
         void flattenPatterns();
+        void collectFlattenedIntervals(const std::vector<std::pair<u64, ptrn::Pattern*>> &children, u64 origin, u64 limit, std::vector<FlattenedInterval> &intervals);
+        void addStridedHighlight(ptrn::Pattern *array, const std::shared_ptr<ptrn::Pattern> &templateRoot, u64 count);
+        void resolveFlattenedPattern(ptrn::Pattern *pattern, u64 start, u64 address, bool updateOffsets, std::vector<ptrn::Pattern*> &results) const;
+        void resolveFlattenedRange(ptrn::Pattern *pattern, u64 patternStart, u64 patternEnd, u64 start, u64 end, std::vector<PatternSpan> &results) const;
+        void waitForFlattenedPatterns() const;
+        [[nodiscard]] const PatternIntervalTree* getFlattenedPatternTree(u64 address, u64 section) const;
 
     private:
         Internals m_internals;
@@ -428,10 +610,12 @@ namespace pl {
 
         std::map<u64, std::vector<std::shared_ptr<ptrn::Pattern>>> m_patterns;
         std::atomic<bool> m_flattenedPatternsValid = false;
-        std::map<u64, wolv::container::IntervalTree<ptrn::Pattern*, u64, 8>> m_flattenedPatterns;
+        std::map<u64, FlattenedSection> m_flattenedPatterns;
+        std::unordered_map<const ptrn::Pattern*, StridedHighlight> m_stridedHighlights;
         std::thread m_flattenThread;
         std::vector<std::function<void(PatternLanguage&)>> m_cleanupCallbacks;
         std::vector<std::shared_ptr<core::ast::ASTNode>> m_currAST;
+        std::vector<core::ast::ASTNode*> m_currStatements;
 
         std::atomic<bool> m_running = false;
         std::atomic<bool> m_patternsValid = false;
@@ -446,18 +630,18 @@ namespace pl {
         u64 m_dataSize;
         std::function<void(u64, u8*, size_t)> m_dataReadFunction;
         std::optional<std::function<void(u64, const u8*, size_t)>> m_dataWriteFunction;
+        std::span<const u8> m_dataSpan;
+        hlp::PageCache m_dataCache;
 
         std::function<bool()> m_dangerousFunctionCallCallback;
         core::LogConsole::Callback m_logCallback;
 
-        struct Function {
-            api::Namespace nameSpace;
-            std::string name;
-            api::FunctionParameterCount parameterCount;
-            api::FunctionCallback callback;
-            bool dangerous;
-        };
         std::vector<Function> m_functions;
+
+        // Builtin functions stay registered in the evaluator across runs. Only functions added since the last run need to be registered again
+        const std::vector<Function> *m_registeredFunctions = nullptr;
+        size_t m_registeredFunctionCount = 0;
+        std::shared_ptr<const CompiledPattern::Data> m_registeredPatternData;
     };
 
 }
\ No newline at end of file
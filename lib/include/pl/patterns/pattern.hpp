@@ -5,14 +5,19 @@
 #include <pl/pattern_visitor.hpp>
 #include <pl/helpers/types.hpp>
 #include <pl/helpers/utils.hpp>
+#include <pl/helpers/copy_on_write.hpp>
+#include <pl/helpers/string_interner.hpp>
 
 #include <fmt/core.h>
 
 #include <wolv/utils/core.hpp>
 #include <wolv/utils/guards.hpp>
 
+#include <array>
 #include <concepts>
 #include <string>
+#include <string_view>
+#include <type_traits>
 
 namespace pl::ptrn {
     using namespace ::std::literals::string_literals;
@@ -34,11 +39,11 @@ namespace pl::ptrn {
         virtual void setEntries(const std::vector<std::shared_ptr<Pattern>> &entries) = 0;
 
         [[nodiscard]] virtual std::shared_ptr<Pattern> getEntry(size_t index) const = 0;
-        void forEachEntry(u64 start, u64 end, const std::function<void(u64, const std::shared_ptr<Pattern>&)> &callback) {
+        virtual void forEachEntry(u64 start, u64 end, const std::function<void(u64, const std::shared_ptr<Pattern>&)> &callback) {
             forEachEntryImpl(this->getEntries(), start, end, callback);
         }
 
-        void forEachEntrySorted(u64 start, u64 end, const std::function<void(u64, const std::shared_ptr<Pattern>&)> &callback) {
+        virtual void forEachEntrySorted(u64 start, u64 end, const std::function<void(u64, const std::shared_ptr<Pattern>&)> &callback) {
             forEachEntryImpl(this->getSortedEntries(), start, end, callback);
         }
 
@@ -59,6 +64,38 @@ namespace pl::ptrn {
         Hidden
     };
 
+    // Concrete type of a pattern. Lets hot code check what it's dealing with without going through RTTI.
+    // Patterns of classes that aren't part of this library are Unknown
+    enum class PatternKind : u8 {
+        Unknown,
+        Unsigned,
+        Signed,
+        Float,
+        Boolean,
+        Character,
+        WideCharacter,
+        String,
+        WideString,
+        Padding,
+        Error,
+        Enum,
+        Pointer,
+        ArrayStatic,
+        ArrayDynamic,
+        Struct,
+        Union,
+        Bitfield,
+        BitfieldArray,
+        BitfieldField,
+        BitfieldFieldSigned,
+        BitfieldFieldBoolean,
+        BitfieldFieldEnum
+    };
+
+    // Kinds that belong to a pattern class or any of its subclasses. Specialized for every pattern class of this library
+    template<typename T>
+    struct PatternKindOf { };
+
     class IIndexable : public IIterable {
     public:
         ~IIndexable() override = default;
@@ -73,19 +110,20 @@ namespace pl::ptrn {
 
     class Pattern : public std::enable_shared_from_this<Pattern> {
     public:
+        // Either getChildren() or getHighlightChildren(), so composite patterns can collect both kinds the same way
+        using ChildrenGetter = std::vector<std::pair<u64, Pattern*>> (Pattern::*)();
+
         constexpr static u64 MainSectionId          = 0x0000'0000'0000'0000;
         constexpr static u64 HeapSectionId          = 0xFFFF'FFFF'FFFF'FFFF;
         constexpr static u64 PatternLocalSectionId  = 0xFFFF'FFFF'FFFF'FFFE;
         constexpr static u64 InstantiationSectionId = 0xFFFF'FFFF'FFFF'FFFD;
 
         Pattern(core::Evaluator *evaluator, u64 offset, size_t size, u32 line)
-            : m_evaluator(evaluator), m_line(line), m_offset(offset), m_size(size) {
+            : m_evaluator(evaluator), m_offset(offset), m_size(size), m_line(line) {
 
             if (evaluator != nullptr) {
                 this->m_color       = evaluator->getNextPatternColor();
                 this->m_manualColor = false;
-                this->m_variableName = m_evaluator->getStringPool().end();
-                this->m_typeName = m_evaluator->getStringPool().end();
 
                 evaluator->patternCreated(this);
             }
@@ -95,24 +133,27 @@ namespace pl::ptrn {
         Pattern(const Pattern &other) : std::enable_shared_from_this<Pattern>(other) {
             this->m_evaluator = other.m_evaluator;
             this->m_offset = other.m_offset;
-            this->m_endian = other.m_endian;
+            this->m_hasEndian = other.m_hasEndian;
+            this->m_bigEndian = other.m_bigEndian;
             this->m_size = other.m_size;
             this->m_color = other.m_color;
             this->m_manualColor = other.m_manualColor;
             this->m_section = other.m_section;
             this->m_initialized = other.m_initialized;
             this->m_constant = other.m_constant;
-            this->m_variableName = other.m_variableName;
-            this->m_typeName = other.m_typeName;
+            this->m_variableNameId = other.m_variableNameId;
+            this->m_typeNameId = other.m_typeNameId;
             this->m_reference = other.m_reference;
             this->m_parent = other.m_parent;
             this->m_arrayIndex = other.m_arrayIndex;
+            this->m_hasArrayIndex = other.m_hasArrayIndex;
             this->m_line = other.m_line;
 
-            if (other.m_cachedDisplayValue != nullptr)
-                this->m_cachedDisplayValue = std::make_unique<std::string>(*other.m_cachedDisplayValue);
-            if (other.m_attributes != nullptr)
-                this->m_attributes = std::make_unique<std::map<std::string, std::vector<core::Token::Literal>>>(*other.m_attributes);
+            if (other.m_caches != nullptr && other.m_caches->displayValue.has_value())
+                this->getCaches().displayValue = other.m_caches->displayValue;
+            this->m_attributes = other.m_attributes;
+            this->m_attributeFlags = other.m_attributeFlags;
+            this->m_kind = other.m_kind;
 
             if (this->m_evaluator != nullptr) {
                 this->m_evaluator->patternCreated(this);
@@ -134,6 +175,8 @@ namespace pl::ptrn {
             return shared_from_this();
         }
 
+        [[nodiscard]] PatternKind getPatternKind() const { return this->m_kind; }
+
         [[nodiscard]] u64 getOffset() const { return this->m_offset; }
         [[nodiscard]] virtual u128 getOffsetForSorting() const { return this->getOffset() << 3; }
         [[nodiscard]] u32 getHeapAddress() const { return this->getOffset() >> 32; }
@@ -156,22 +199,40 @@ namespace pl::ptrn {
 
         [[nodiscard]] std::string getVariableName() const {
             if (!hasVariableName()) {
-                if (this->m_arrayIndex.has_value())
-                    return fmt::format("[{}]", m_arrayIndex.value());
+                if (this->m_hasArrayIndex)
+                    return fmt::format("[{}]", this->m_arrayIndex);
                 else
                     return fmt::format("{} @ 0x{:02X}", this->getTypeName(), this->getOffset());
             } else
-                return *this->m_variableName;
+                return std::string(this->getInternedString(this->m_variableNameId));
         }
 
         [[nodiscard]] bool hasVariableName() const {
-            return getEvaluator()->isStringPoolEntryValid(this->m_variableName);
+            return this->m_variableNameId != hlp::StringInterner::None;
+        }
+
+        // Id of the name in the evaluator's string interner. Patterns of the same evaluator with the same name share the same id
+        [[nodiscard]] hlp::StringInterner::Id getVariableNameId() const {
+            return this->m_variableNameId;
+        }
+
+        // Same as comparing the results of getVariableName() but doesn't need to build the names if both patterns are named
+        [[nodiscard]] bool hasSameVariableName(const Pattern &other) const {
+            if (this->m_evaluator == other.m_evaluator && this->hasVariableName() && other.hasVariableName())
+                return this->m_variableNameId == other.m_variableNameId;
+            else
+                return this->getVariableName() == other.getVariableName();
         }
 
         void setVariableName(const std::string &name) {
             if (!name.empty()) {
-                auto [it, inserted] = m_evaluator->getStringPool().emplace(name);
-                this->m_variableName = it;
+                const auto id = m_evaluator->getStringInterner().intern(name);
+
+                // The pattern might already be part of a scope that indexed it under its old name
+                if (hasVariableName() && id != this->m_variableNameId)
+                    m_evaluator->invalidateVariableLookups();
+
+                this->m_variableNameId = id;
             }
         }
 
@@ -188,17 +249,12 @@ namespace pl::ptrn {
         }
 
         [[nodiscard]] virtual std::string getTypeName() const {
-            if (!getEvaluator()->isStringPoolEntryValid(this->m_typeName))
-                return "";
-            else
-                return *this->m_typeName;
+            return std::string(this->getInternedString(this->m_typeNameId));
         }
 
         void setTypeName(const std::string &name) {
-            if (!name.empty()) {
-                auto [it, inserted] = m_evaluator->getStringPool().emplace(name);
-                this->m_typeName = it;
-            }
+            if (!name.empty())
+                this->m_typeNameId = m_evaluator->getStringInterner().intern(name);
         }
 
         [[nodiscard]] u32 getColor() const { return this->m_color; }
@@ -216,15 +272,16 @@ namespace pl::ptrn {
 
         [[nodiscard]] std::endian getEndian() const {
             if (this->m_evaluator == nullptr) return std::endian::native;
-            else return this->m_endian.value_or(this->m_evaluator->getDefaultEndian());
+            else return this->getOverriddenEndian().value_or(this->m_evaluator->getDefaultEndian());
         }
         virtual void setEndian(std::endian endian) {
             if (m_section == HeapSectionId || m_section == PatternLocalSectionId || m_section == InstantiationSectionId)
                 return;
 
-            this->m_endian = endian;
+            this->m_hasEndian = true;
+            this->m_bigEndian = endian == std::endian::big;
         }
-        [[nodiscard]] bool hasOverriddenEndian() const { return this->m_endian.has_value(); }
+        [[nodiscard]] bool hasOverriddenEndian() const { return this->m_hasEndian; }
 
         [[nodiscard]] std::string getDisplayName() const {
             if (const auto &arguments = this->getAttributeArguments("name"); !arguments.empty())
@@ -235,6 +292,9 @@ namespace pl::ptrn {
         void setDisplayName(const std::string &name) { this->addAttribute("name", { name }); }
 
         [[nodiscard]] std::string getTransformFunction() const {
+            if ((this->m_attributeFlags & AttributeTransform) == 0)
+                return "";
+
             if (const auto &arguments = this->getAttributeArguments("transform"); !arguments.empty())
                 return arguments.front().toString(true);
             else
@@ -242,6 +302,9 @@ namespace pl::ptrn {
         }
         void setTransformFunction(const std::string &functionName) { this->addAttribute("transform", { functionName }); }
         [[nodiscard]] std::string getReadFormatterFunction() const {
+            if ((this->m_attributeFlags & AttributeFormatRead) == 0)
+                return "";
+
             if (const auto &arguments = this->getAttributeArguments("format_read"); !arguments.empty())
                 return arguments.front().toString(true);
             else
@@ -249,6 +312,9 @@ namespace pl::ptrn {
         }
         void setReadFormatterFunction(const std::string &functionName) { this->addAttribute("format_read", { functionName }); }
         [[nodiscard]] std::string getWriteFormatterFunction() const {
+            if ((this->m_attributeFlags & AttributeFormatWrite) == 0)
+                return "";
+
             if (const auto &arguments = this->getAttributeArguments("format_write"); !arguments.empty())
                 return arguments.front().toString(true);
             else
@@ -259,8 +325,8 @@ namespace pl::ptrn {
         [[nodiscard]] virtual std::string getFormattedName() const = 0;
 
         [[nodiscard]] std::string getFormattedValue() {
-            if (this->m_cachedDisplayValue != nullptr)
-                return *this->m_cachedDisplayValue;
+            if (this->m_caches != nullptr && this->m_caches->displayValue.has_value())
+                return *this->m_caches->displayValue;
 
             try {
                 auto startOffset = this->m_evaluator->getReadOffset();
@@ -271,15 +337,16 @@ namespace pl::ptrn {
                 };
 
                 auto result = this->formatDisplayValue();
-                this->m_cachedDisplayValue = std::make_unique<std::string>(result);
+                this->getCaches().displayValue = result;
                 this->m_validDisplayValue = true;
 
                 return result;
             } catch(std::exception &e) {
-                this->m_cachedDisplayValue = std::make_unique<std::string>(e.what());
+                auto &displayValue = this->getCaches().displayValue;
+                displayValue = e.what();
                 this->m_validDisplayValue = false;
 
-                return *this->m_cachedDisplayValue;
+                return *displayValue;
             }
         }
 
@@ -310,6 +377,15 @@ namespace pl::ptrn {
                 return { { this->getOffset(), this } };
         }
 
+        /**
+         * @brief Gets the highlighted children like getChildren() but keeps arrays the runtime highlights arithmetically in one piece
+         * @note Static arrays are returned as a whole instead of one child per member of every entry
+         * @return Address and pattern of every child
+         */
+        [[nodiscard]] virtual std::vector<std::pair<u64, Pattern*>> getHighlightChildren() {
+            return this->getChildren();
+        }
+
         void setVisibility(Visibility visibility) {
             switch (visibility) {
                 case Visibility::Visible:
@@ -336,11 +412,11 @@ namespace pl::ptrn {
         }
 
         [[nodiscard]] Visibility getVisibility() const {
-            if (this->hasAttribute("hidden"))
+            if ((this->m_attributeFlags & AttributeHidden) != 0)
                 return Visibility::Hidden;
-            else if (this->hasAttribute("highlight_hidden"))
+            else if ((this->m_attributeFlags & AttributeHighlightHidden) != 0)
                 return Visibility::HighlightHidden;
-            else if (this->hasAttribute("tree_hidden"))
+            else if ((this->m_attributeFlags & AttributeTreeHidden) != 0)
                 return Visibility::TreeHidden;
             else
                 return Visibility::Visible;
@@ -354,7 +430,11 @@ namespace pl::ptrn {
         }
 
         [[nodiscard]] bool isSealed() const {
-            return this->hasAttribute("sealed") || this->getVisibility() == Visibility::Hidden;
+            return (this->m_attributeFlags & (AttributeSealed | AttributeHidden)) != 0;
+        }
+
+        [[nodiscard]] bool isExported() const {
+            return (this->m_attributeFlags & AttributeExport) != 0;
         }
 
         virtual void setLocal(bool local) {
@@ -408,8 +488,8 @@ namespace pl::ptrn {
 
         virtual std::vector<u8> getRawBytes() = 0;
         const std::vector<u8>& getBytes() {
-            if (this->m_cachedBytes != nullptr)
-                return *this->m_cachedBytes;
+            if (this->m_caches != nullptr && this->m_caches->bytes.has_value())
+                return *this->m_caches->bytes;
 
             std::vector<u8> result;
             if (!this->getTransformFunction().empty()) {
@@ -435,9 +515,10 @@ namespace pl::ptrn {
                 result = this->getRawBytes();
             }
 
-            this->m_cachedBytes = std::make_unique<std::vector<u8>>(std::move(result));
+            auto &bytes = this->getCaches().bytes;
+            bytes = std::move(result);
 
-            return *this->m_cachedBytes;
+            return *bytes;
         }
 
         virtual std::vector<u8> getBytesOf(const core::Token::Literal &value) const {
@@ -457,10 +538,10 @@ namespace pl::ptrn {
                 result = this->getBytesOf(value);
             } else {
                 try {
-                    const auto function = this->m_evaluator->findFunction(formatterFunctionName);
-                    if (function.has_value()) {
-                        auto startHeap = this->m_evaluator->getHeap();
-                        ON_SCOPE_EXIT { this->m_evaluator->getHeap() = startHeap; };
+                    const auto function = this->m_evaluator->getFunction(formatterFunctionName);
+                    if (function != nullptr) {
+                        this->m_evaluator->pushHeapCheckpoint();
+                        ON_SCOPE_EXIT { this->m_evaluator->popHeapCheckpoint(); };
 
                         auto formatterResult = function->func(this->m_evaluator, { value });
                         if (formatterResult.has_value()) {
@@ -479,14 +560,18 @@ namespace pl::ptrn {
         }
 
         virtual void clearFormatCache() {
-            this->m_cachedDisplayValue.reset();
+            if (this->m_caches != nullptr)
+                this->m_caches->displayValue.reset();
         }
 
         void clearByteCache() {
-            if (this->m_cachedBytes == nullptr)
+            if (this->m_caches == nullptr || !this->m_caches->bytes.has_value())
                 return;
 
-            this->m_cachedBytes.reset();
+            this->m_caches->bytes.reset();
+
+            if (!this->mayHaveEntries())
+                return;
 
             if (auto *iterable = dynamic_cast<IIterable*>(this); iterable != nullptr) [[unlikely]] {
                 iterable->forEachEntry(0, iterable->getEntryCount(), [](u64, const auto &pattern) {
@@ -498,39 +583,71 @@ namespace pl::ptrn {
         virtual void accept(PatternVisitor &v) = 0;
 
         void addAttribute(const std::string &attribute, const std::vector<core::Token::Literal> &arguments = {}) {
-            if (this->m_attributes == nullptr)
-                this->m_attributes = std::make_unique<std::map<std::string, std::vector<core::Token::Literal>>>();
+            // Keep sharing the attribute set if it already contains the exact same attribute
+            const auto attributes = this->m_attributes.get();
+            if (attributes == nullptr || !attributes->contains(attribute) || attributes->at(attribute) != arguments)
+                this->m_attributes.modify()[attribute] = arguments;
 
-            (*this->m_attributes)[attribute] = arguments;
+            this->m_attributeFlags |= getAttributeFlag(attribute);
             getEvaluator()->addAttributedPattern(attribute, this);
         }
 
         void removeAttribute(const std::string &attribute) {
-            if (this->m_attributes != nullptr)
-                this->m_attributes->erase(attribute);
+            if (const auto attributes = this->m_attributes.get(); attributes != nullptr && attributes->contains(attribute)) {
+                this->m_attributes.modify().erase(attribute);
+                this->m_attributeFlags &= ~getAttributeFlag(attribute);
+            }
             getEvaluator()->removeAttributedPattern(attribute, this);
         }
 
+        /**
+         * @brief Adds a whole set of attributes at once
+         * @note Patterns that don't have any attributes yet share the set instead of copying it
+         * @param attributes Attributes to add
+         */
+        void addAttributes(const hlp::CopyOnWrite<AttributeMap> &attributes) {
+            const auto newAttributes = attributes.get();
+            if (newAttributes == nullptr || newAttributes->empty())
+                return;
+
+            if (this->m_attributes.get() == nullptr) {
+                this->m_attributes = attributes;
+            } else {
+                auto &ownAttributes = this->m_attributes.modify();
+                for (const auto &[name, arguments] : *newAttributes)
+                    ownAttributes[name] = arguments;
+            }
+
+            for (const auto &[name, arguments] : *newAttributes) {
+                this->m_attributeFlags |= getAttributeFlag(name);
+                getEvaluator()->addAttributedPattern(name, this);
+            }
+        }
+
         [[nodiscard]] bool hasAttribute(const std::string &attribute) const {
-            if (this->m_attributes == nullptr)
+            const auto attributes = this->m_attributes.get();
+            if (attributes == nullptr)
                 return false;
 
-            return this->m_attributes->contains(attribute);
+            if (const auto flag = getAttributeFlag(attribute); flag != 0)
+                return (this->m_attributeFlags & flag) != 0;
+            else
+                return attributes->contains(attribute);
         }
 
-        [[nodiscard]] const auto &getAttributes() const {
-            return this->m_attributes;
+        [[nodiscard]] const AttributeMap* getAttributes() const {
+            return this->m_attributes.get();
         }
 
         [[nodiscard]] std::vector<core::Token::Literal> getAttributeArguments(const std::string &name) const {
             if (!this->hasAttribute(name))
                 return {};
             else
-                return this->m_attributes->at(name);
+                return this->m_attributes.get()->at(name);
         }
 
         void setFormatValue(const std::string &value) {
-            this->m_cachedDisplayValue = std::make_unique<std::string>(value);
+            this->getCaches().displayValue = value;
         }
 
         [[nodiscard]] core::Evaluator* getEvaluator() const {
@@ -569,19 +686,18 @@ namespace pl::ptrn {
 
         void setArrayIndex(u64 index) {
             m_arrayIndex = index;
+            m_hasArrayIndex = true;
         }
 
         [[nodiscard]] virtual std::string formatDisplayValue() = 0;
 
     protected:
-        std::optional<std::endian> m_endian;
-
         [[nodiscard]] core::Token::Literal transformValue(const core::Token::Literal &value) const {
             auto evaluator = this->getEvaluator();
 
-            if (auto transformFunc = evaluator->findFunction(this->getTransformFunction()); transformFunc.has_value()) {
-                auto startHeap = this->m_evaluator->getHeap();
-                ON_SCOPE_EXIT { this->m_evaluator->getHeap() = startHeap; };
+            if (auto transformFunc = evaluator->getFunction(this->getTransformFunction()); transformFunc != nullptr) {
+                this->m_evaluator->pushHeapCheckpoint();
+                ON_SCOPE_EXIT { this->m_evaluator->popHeapCheckpoint(); };
 
                 // Preserve pattern variable name
                 std::string patternName;
@@ -609,10 +725,10 @@ namespace pl::ptrn {
             if (formatterFunctionName.empty())
                 return {};
             else {
-                const auto function = this->m_evaluator->findFunction(formatterFunctionName);
-                if (function.has_value()) {
-                    auto startHeap = this->m_evaluator->getHeap();
-                    ON_SCOPE_EXIT { this->m_evaluator->getHeap() = startHeap; };
+                const auto function = this->m_evaluator->getFunction(formatterFunctionName);
+                if (function != nullptr) {
+                    this->m_evaluator->pushHeapCheckpoint();
+                    ON_SCOPE_EXIT { this->m_evaluator->popHeapCheckpoint(); };
 
                     // Preserve pattern variable name
                     std::string patternName;
@@ -637,47 +753,157 @@ namespace pl::ptrn {
             }
         }
 
+        void setPatternKind(PatternKind kind) { this->m_kind = kind; }
+
+        // Copies are placed in the same arena as the pattern they're made from
+        template<typename T>
+        [[nodiscard]] static std::shared_ptr<T> copyPattern(const T &pattern) {
+            if (auto evaluator = pattern.getEvaluator(); evaluator != nullptr)
+                return std::allocate_shared<T>(std::pmr::polymorphic_allocator<T>(&evaluator->getPatternArena()), pattern);
+            else
+                return std::make_shared<T>(pattern);
+        }
+
         template<typename T>
         [[nodiscard]] bool compareCommonProperties(const Pattern &other) const {
+            const auto thisEndian = this->getOverriddenEndian(), otherEndian = other.getOverriddenEndian();
+
             return typeid(other) == typeid(std::remove_cvref_t<T>) &&
                    this->m_offset == other.m_offset &&
                    this->m_size == other.m_size &&
-                   (this->m_attributes == nullptr || other.m_attributes == nullptr || *this->m_attributes == *other.m_attributes) &&
-                   (this->m_endian == other.m_endian || (!this->m_endian.has_value() && other.m_endian == std::endian::native) || (!other.m_endian.has_value() && this->m_endian == std::endian::native)) &&
-                   *this->m_variableName == *other.m_variableName &&
-                   *this->m_typeName == *other.m_typeName &&
+                   (this->m_attributes.get() == nullptr || other.m_attributes.get() == nullptr || *this->m_attributes.get() == *other.m_attributes.get()) &&
+                   (thisEndian == otherEndian || (!thisEndian.has_value() && otherEndian == std::endian::native) || (!otherEndian.has_value() && thisEndian == std::endian::native)) &&
+                   (this->m_evaluator == other.m_evaluator ?
+                        this->m_variableNameId == other.m_variableNameId && this->m_typeNameId == other.m_typeNameId :
+                        this->getInternedString(this->m_variableNameId) == other.getInternedString(other.m_variableNameId) &&
+                        this->getInternedString(this->m_typeNameId) == other.getInternedString(other.m_typeNameId)) &&
                    this->m_section == other.m_section;
         }
 
-    protected:
-        std::unique_ptr<std::string> m_cachedDisplayValue;
-        bool m_validDisplayValue = false;
-        std::unique_ptr<std::vector<u8>> m_cachedBytes;
-
     private:
         friend pl::core::Evaluator;
 
+        // Values that only get computed for patterns that are displayed or exported. Allocated on first use
+        struct Caches {
+            std::optional<std::string> displayValue;
+            std::optional<std::vector<u8>> bytes;
+        };
+
+        [[nodiscard]] Caches& getCaches() {
+            if (this->m_caches == nullptr)
+                this->m_caches = std::make_unique<Caches>();
+
+            return *this->m_caches;
+        }
+
+        // Attributes that get checked for most patterns, mirrored as flags so checking them doesn't need a lookup
+        enum AttributeFlag : u8 {
+            AttributeHidden          = 1 << 0,
+            AttributeHighlightHidden = 1 << 1,
+            AttributeTreeHidden      = 1 << 2,
+            AttributeSealed          = 1 << 3,
+            AttributeExport          = 1 << 4,
+            AttributeTransform       = 1 << 5,
+            AttributeFormatRead      = 1 << 6,
+            AttributeFormatWrite     = 1 << 7
+        };
+
+        [[nodiscard]] static u8 getAttributeFlag(std::string_view attribute) {
+            constexpr static std::array<std::pair<std::string_view, AttributeFlag>, 8> Flags = {{
+                { "hidden",           AttributeHidden          },
+                { "highlight_hidden", AttributeHighlightHidden },
+                { "tree_hidden",      AttributeTreeHidden      },
+                { "sealed",           AttributeSealed          },
+                { "export",           AttributeExport          },
+                { "transform",        AttributeTransform       },
+                { "format_read",      AttributeFormatRead      },
+                { "format_write",     AttributeFormatWrite     }
+            }};
+
+            for (const auto &[name, flag] : Flags) {
+                if (name == attribute)
+                    return flag;
+            }
+
+            return 0;
+        }
+
+        [[nodiscard]] bool mayHaveEntries() const {
+            switch (this->m_kind) {
+                case PatternKind::Unknown:
+                case PatternKind::String:
+                case PatternKind::WideString:
+                case PatternKind::ArrayStatic:
+                case PatternKind::ArrayDynamic:
+                case PatternKind::Struct:
+                case PatternKind::Union:
+                case PatternKind::Bitfield:
+                case PatternKind::BitfieldArray:
+                    return true;
+                default:
+                    return false;
+            }
+        }
+
+        [[nodiscard]] std::string_view getInternedString(hlp::StringInterner::Id id) const {
+            if (id == hlp::StringInterner::None || this->m_evaluator == nullptr)
+                return { };
+
+            return this->m_evaluator->getStringInterner().get(id);
+        }
+
+        [[nodiscard]] std::optional<std::endian> getOverriddenEndian() const {
+            if (!this->m_hasEndian)
+                return std::nullopt;
+
+            return this->m_bigEndian ? std::endian::big : std::endian::little;
+        }
+
         core::Evaluator *m_evaluator;
 
-        std::unique_ptr<std::map<std::string, std::vector<core::Token::Literal>>> m_attributes;
+        hlp::CopyOnWrite<AttributeMap> m_attributes;
+        std::unique_ptr<Caches> m_caches;
         std::weak_ptr<Pattern> m_parent;
-        u32 m_line = 0;
 
-        std::set<std::string>::const_iterator m_variableName;
-        std::set<std::string>::const_iterator m_typeName;
-        std::optional<u64> m_arrayIndex;
-
-        u64 m_offset  = 0x00;
-        size_t m_size = 0x00;
-        u64 m_section = 0x00;
+        u64 m_offset     = 0x00;
+        size_t m_size    = 0x00;
+        u64 m_section    = 0x00;
+        u64 m_arrayIndex = 0x00;
 
+        u32 m_line  = 0;
         u32 m_color = 0x00;
 
-        bool m_reference = false;
-        bool m_constant = false;
-        bool m_initialized = false;
-
-        bool m_manualColor = false;
+        hlp::StringInterner::Id m_variableNameId = hlp::StringInterner::None;
+        hlp::StringInterner::Id m_typeNameId     = hlp::StringInterner::None;
+
+        // Packed into a single byte since every pattern carries them
+        bool m_hasArrayIndex     : 1 = false;
+        bool m_hasEndian         : 1 = false;
+        bool m_bigEndian         : 1 = false;
+        bool m_reference         : 1 = false;
+        bool m_constant          : 1 = false;
+        bool m_initialized       : 1 = false;
+        bool m_manualColor       : 1 = false;
+        bool m_validDisplayValue : 1 = false;
+
+        u8 m_attributeFlags = 0;
+        PatternKind m_kind = PatternKind::Unknown;
     };
 
+    // Casts a pattern to one of the pattern classes by checking its kind instead of using RTTI.
+    // Falls back to dynamic_cast for targets without a kind, like the IIterable and IInlinable interfaces
+    template<typename T, typename P> requires std::derived_from<std::remove_const_t<P>, Pattern>
+    [[nodiscard]] auto pattern_cast(P *pattern) -> std::conditional_t<std::is_const_v<P>, const T, T>* {
+        using Target = std::conditional_t<std::is_const_v<P>, const T, T>;
+
+        if constexpr (requires(PatternKind kind) { PatternKindOf<std::remove_const_t<T>>::matches(kind); }) {
+            if (pattern == nullptr || !PatternKindOf<std::remove_const_t<T>>::matches(pattern->getPatternKind()))
+                return nullptr;
+
+            return static_cast<Target*>(pattern);
+        } else {
+            return dynamic_cast<Target*>(pattern);
+        }
+    }
+
 }
@@ -2,16 +2,50 @@
 
 #include <pl/patterns/pattern.hpp>
 
+#include <functional>
+#include <limits>
+#include <list>
+#include <map>
+
 namespace pl::ptrn {
 
     class PatternArrayDynamic : public Pattern,
                                 public IInlinable,
                                 public IIndexable {
     public:
+        // Location of an entry of a lazy array, discovered while the array was being created
+        struct LazyEntry {
+            u64 offset;
+            size_t size;
+        };
+
+        // Creates the pattern of the entry of the given array with the given index at the given offset again
+        using EntryMaterializer = std::function<std::shared_ptr<Pattern>(const Pattern &array, u64 index, u64 offset)>;
+        using EntryModifier = std::function<void(const std::shared_ptr<Pattern>&)>;
+
         PatternArrayDynamic(core::Evaluator *evaluator, u64 offset, size_t size, u32 line)
-            : Pattern(evaluator, offset, size, line) { }
+            : Pattern(evaluator, offset, size, line) {
+            this->setPatternKind(PatternKind::ArrayDynamic);
+        }
 
         PatternArrayDynamic(const PatternArrayDynamic &other) : Pattern(other) {
+            if (other.m_lazy != nullptr) {
+                if (other.m_lazy->entryTemplate != nullptr) {
+                    this->setCompactEntries(other.m_lazy->entries, other.m_lazy->entryTemplate->clone());
+
+                    // Entries of compact arrays that have been accessed may have been changed since, so they're copied as well
+                    for (auto it = other.m_lazy->recentlyUsed.rbegin(); it != other.m_lazy->recentlyUsed.rend(); ++it) {
+                        this->m_lazy->recentlyUsed.push_front(*it);
+                        this->m_lazy->cache.insert({ *it, { other.m_lazy->cache.at(*it).pattern->clone(), this->m_lazy->recentlyUsed.begin() } });
+                    }
+                } else {
+                    this->setLazyEntries(other.m_lazy->entries, other.m_lazy->typeName, other.m_lazy->materializer, other.m_lazy->cacheLimit);
+                    this->m_lazy->modifiers = other.m_lazy->modifiers;
+                }
+
+                return;
+            }
+
             std::vector<std::shared_ptr<Pattern>> entries;
             entries.reserve(other.m_entries.size());
             for (const auto &entry : other.m_entries)
@@ -21,29 +55,33 @@ namespace pl::ptrn {
         }
 
         [[nodiscard]] std::shared_ptr<Pattern> clone() const override {
-            auto other = std::make_shared<PatternArrayDynamic>(*this);
-            for (const auto &entry : other->m_entries)
+            auto other = copyPattern(*this);
+            other->forEachLoadedEntry([&other](const auto &entry) {
                 entry->setParent(other->reference());
+            });
 
             return other;
         }
 
         void setColor(u32 color) override {
             Pattern::setColor(color);
-            for (auto &entry : this->m_entries) {
+            this->forEachLoadedEntry([color](const auto &entry) {
                 if (!entry->hasOverriddenColor())
                     entry->setColor(color);
-            }
+            });
         }
 
         [[nodiscard]] std::string getFormattedName() const override {
-            if (this->m_entries.empty())
+            if (this->getEntryCount() == 0)
                 return "???";
 
-            return this->m_entries.front()->getTypeName() + "[" + std::to_string(this->m_entries.size()) + "]";
+            return this->getTypeName() + "[" + std::to_string(this->getEntryCount()) + "]";
         }
 
         [[nodiscard]] std::string getTypeName() const override {
+            if (this->m_lazy != nullptr)
+                return this->m_lazy->typeName;
+
             if (this->m_entries.empty())
                 return "???";
 
@@ -51,9 +89,14 @@ namespace pl::ptrn {
         }
 
         void setOffset(u64 offset) override {
-            for (auto &entry : this->m_entries) {
+            this->forEachLoadedEntry([this, offset](const auto &entry) {
                 if (entry->getSection() == this->getSection() && entry->getSection() != ptrn::Pattern::PatternLocalSectionId)
                     entry->setOffset(entry->getOffset() - this->getOffset() + offset);
+            });
+
+            if (this->m_lazy != nullptr) {
+                for (auto &entry : this->m_lazy->entries)
+                    entry.offset = entry.offset - this->getOffset() + offset;
             }
 
             Pattern::setOffset(offset);
@@ -63,54 +106,78 @@ namespace pl::ptrn {
             if (this->getSection() == id)
                 return;
 
-            for (auto &entry : this->m_entries)
+            this->forEachLoadedEntry([id](const auto &entry) {
                 entry->setSection(id);
+            });
 
             Pattern::setSection(id);
         }
 
         [[nodiscard]] std::vector<std::pair<u64, Pattern*>> getChildren() override {
-            if (this->getVisibility() == Visibility::HighlightHidden)
-                return { };
-
-            std::vector<std::pair<u64, Pattern*>> result;
-
-            for (const auto &entry : this->m_entries) {
-                auto children = entry->getChildren();
-                std::ranges::move(children, std::back_inserter(result));
-            }
+            return this->getEntryChildren(&Pattern::getChildren);
+        }
 
-            return result;
+        [[nodiscard]] std::vector<std::pair<u64, Pattern*>> getHighlightChildren() override {
+            return this->getEntryChildren(&Pattern::getHighlightChildren);
         }
 
         void setLocal(bool local) override {
-            for (auto &pattern : this->m_entries)
-                pattern->setLocal(local);
+            this->forEachLoadedEntry([local](const auto &entry) {
+                entry->setLocal(local);
+            });
 
             Pattern::setLocal(local);
         }
 
         void setReference(bool reference) override {
-            for (auto &pattern : this->m_entries)
-                pattern->setReference(reference);
+            this->forEachLoadedEntry([reference](const auto &entry) {
+                entry->setReference(reference);
+            });
 
             Pattern::setReference(reference);
         }
 
         [[nodiscard]] std::shared_ptr<Pattern> getEntry(size_t index) const override {
+            if (this->m_lazy != nullptr)
+                return this->loadLazyEntry(index);
+
             return this->m_entries[index];
         }
 
         [[nodiscard]] size_t getEntryCount() const override {
+            if (this->m_lazy != nullptr)
+                return this->m_lazy->entries.size();
+
             return this->m_entries.size();
         }
 
         [[nodiscard]] std::vector<std::shared_ptr<Pattern>> getEntries() override {
+            if (this->m_lazy != nullptr) {
+                std::vector<std::shared_ptr<Pattern>> entries;
+                entries.reserve(this->m_lazy->entries.size());
+                for (u64 i = 0; i < this->m_lazy->entries.size(); i++)
+                    entries.push_back(this->loadLazyEntry(i));
+
+                return entries;
+            }
+
             return this->m_entries;
         }
 
         [[nodiscard]] std::vector<std::shared_ptr<Pattern>> getSortedEntries() override {
-            return this->m_entries;
+            return this->getEntries();
+        }
+
+        void forEachEntry(u64 start, u64 end, const std::function<void(u64, const std::shared_ptr<Pattern>&)> &callback) override {
+            // Lazy entries are created one by one while iterating instead of all of them upfront
+            if (this->m_lazy != nullptr)
+                this->forEachEntryImpl({ }, start, end, callback);
+            else
+                IIterable::forEachEntry(start, end, callback);
+        }
+
+        void forEachEntrySorted(u64 start, u64 end, const std::function<void(u64, const std::shared_ptr<Pattern>&)> &callback) override {
+            this->forEachEntry(start, end, callback);
         }
 
         void forEachEntryImpl(const std::vector<std::shared_ptr<Pattern>> &patterns, u64 start, u64 end, const std::function<void(u64, const std::shared_ptr<Pattern>&)>& fn) override {
@@ -124,23 +191,31 @@ namespace pl::ptrn {
                     evaluator->clearCurrentArrayIndex();
             };
 
-            for (u64 i = start; i < std::min<u64>(end, patterns.size()); i++) {
+            const auto count = this->m_lazy != nullptr ? this->m_lazy->entries.size() : patterns.size();
+            for (u64 i = start; i < std::min<u64>(end, count); i++) {
                 evaluator->setCurrentArrayIndex(i);
 
-                auto &entry = patterns[i];
-                if (!entry->isPatternLocal() || entry->hasAttribute("export"))
+                const auto entry = this->m_lazy != nullptr ? this->loadLazyEntry(i) : patterns[i];
+                if (!entry->isPatternLocal() || entry->isExported())
                     fn(i, entry);
             }
         }
 
         void sort(const std::function<bool (const Pattern *, const Pattern *)> &comparator) override {
-            for (auto &member : this->m_entries)
-                member->sort(comparator);
+            this->forEachLoadedEntry([&comparator](const auto &entry) {
+                entry->sort(comparator);
+            });
         }
 
         void addEntry(const std::shared_ptr<Pattern> &entry) override {
             if (entry == nullptr) return;
 
+            // Entries can only be appended to arrays that hold all of their entries
+            if (this->m_lazy != nullptr) {
+                this->m_entries = this->getEntries();
+                this->m_lazy.reset();
+            }
+
             if (!entry->hasOverriddenColor())
                 entry->setBaseColor(this->getColor());
 
@@ -149,6 +224,7 @@ namespace pl::ptrn {
 
         void setEntries(const std::vector<std::shared_ptr<Pattern>> &entries) override {
             this->m_entries.clear();
+            this->m_lazy.reset();
 
             for (const auto &entry : entries) {
                 addEntry(entry);
@@ -164,13 +240,13 @@ namespace pl::ptrn {
             result += "[ ";
 
             size_t entryCount = 0;
-            for (const auto &entry : this->m_entries) {
+            for (u64 i = 0; i < this->getEntryCount(); i++) {
                 if (entryCount > 50) {
                     result += fmt::format("..., ");
                     break;
                 }
 
-                result += fmt::format("{}, ", entry->toString());
+                result += fmt::format("{}, ", this->getEntry(i)->toString());
                 entryCount++;
             }
 
@@ -190,11 +266,11 @@ namespace pl::ptrn {
                 return false;
 
             auto &otherArray = *static_cast<const PatternArrayDynamic *>(&other);
-            if (this->m_entries.size() != otherArray.m_entries.size())
+            if (this->getEntryCount() != otherArray.getEntryCount())
                 return false;
 
-            for (u64 i = 0; i < this->m_entries.size(); i++) {
-                if (*this->m_entries[i] != *otherArray.m_entries[i])
+            for (u64 i = 0; i < this->getEntryCount(); i++) {
+                if (*this->getEntry(i) != *otherArray.getEntry(i))
                     return false;
             }
 
@@ -206,10 +282,9 @@ namespace pl::ptrn {
 
             Pattern::setEndian(endian);
 
-            for (auto &entry : this->m_entries) {
+            this->forEachLoadedEntry([endian](const auto &entry) {
                 entry->setEndian(endian);
-            }
-
+            });
         }
 
         void accept(PatternVisitor &v) override {
@@ -237,15 +312,187 @@ namespace pl::ptrn {
         }
 
         void clearFormatCache() override {
-            this->forEachEntry(0, this->getEntryCount(), [&](u64, const auto &entry) {
+            // Entries that aren't loaded don't have a cache yet
+            this->forEachLoadedEntry([](const auto &entry) {
                 entry->clearFormatCache();
             });
 
             Pattern::clearFormatCache();
         }
 
+        /**
+         * @brief Turns the array into a lazy array that only keeps the location of its entries around
+         * @param entries Locations of all entries
+         * @param typeName Type name of the entries
+         * @param materializer Function that creates an entry again when it's accessed
+         * @param cacheLimit Maximum number of entries that are kept in memory at the same time
+         */
+        void setLazyEntries(std::vector<LazyEntry> entries, std::string typeName, EntryMaterializer materializer, size_t cacheLimit) {
+            this->m_entries.clear();
+
+            this->m_lazy = std::make_unique<LazyState>();
+            this->m_lazy->entries = std::move(entries);
+            this->m_lazy->typeName = std::move(typeName);
+            this->m_lazy->materializer = std::move(materializer);
+            this->m_lazy->cacheLimit = std::max<size_t>(cacheLimit, 1);
+        }
+
+        /**
+         * @brief Turns the array into a compact array whose entries are all copies of a single template at different offsets
+         * @note Entries are only created once they're accessed and then kept, so changes made to them aren't lost
+         * @param entries Locations of all entries
+         * @param entryTemplate Pattern every entry is a copy of
+         */
+        void setCompactEntries(std::vector<LazyEntry> entries, std::shared_ptr<Pattern> entryTemplate) {
+            auto typeName = entryTemplate->getTypeName();
+            this->setLazyEntries(std::move(entries), std::move(typeName), nullptr, std::numeric_limits<size_t>::max());
+
+            auto &lazy = *this->m_lazy;
+            lazy.entryTemplate = std::move(entryTemplate);
+
+            // Entries of the same size that directly follow each other can be highlighted the same way as the ones of static arrays
+            const auto stride = lazy.entryTemplate->getSize();
+            lazy.uniformStride = !lazy.entries.empty() && stride > 0;
+            for (u64 i = 0; i < lazy.entries.size() && lazy.uniformStride; i++)
+                lazy.uniformStride = lazy.entries[i].offset == this->getOffset() + i * stride && lazy.entries[i].size == stride;
+        }
+
+        /**
+         * @brief Applies a change to every entry, including the ones of lazy arrays that haven't been created yet
+         * @param modifier Function to call on every entry
+         */
+        void modifyEntries(const EntryModifier &modifier) {
+            this->forEachLoadedEntry(modifier);
+
+            if (this->m_lazy != nullptr && this->m_lazy->entryTemplate == nullptr)
+                this->m_lazy->modifiers.push_back(modifier);
+        }
+
+        [[nodiscard]] bool isLazy() const {
+            return this->m_lazy != nullptr;
+        }
+
+        // Copy of the first entry of a compact array with equally spaced entries that the runtime moves around to highlight all of them
+        [[nodiscard]] std::shared_ptr<Pattern> getHighlightTemplate() {
+            if (this->m_lazy == nullptr || this->m_lazy->entryTemplate == nullptr || !this->m_lazy->uniformStride)
+                return nullptr;
+
+            auto &lazy = *this->m_lazy;
+            if (lazy.highlightTemplate == nullptr) {
+                lazy.highlightTemplate = this->loadLazyEntry(0)->clone();
+                lazy.highlightTemplate->setVariableName(this->getVariableName());
+                lazy.highlightTemplate->setOffset(this->getOffset());
+            }
+
+            return lazy.highlightTemplate;
+        }
+
     private:
+        [[nodiscard]] std::vector<std::pair<u64, Pattern*>> getEntryChildren(ChildrenGetter childrenGetter) {
+            if (this->getVisibility() == Visibility::HighlightHidden)
+                return { };
+
+            // Looking up addresses would require creating every entry, so lazy arrays are highlighted as a whole.
+            // Compact arrays with a highlight template get their entries highlighted by the runtime like static arrays
+            if (this->m_lazy != nullptr)
+                return { { this->getOffset(), this } };
+
+            std::vector<std::pair<u64, Pattern*>> result;
+
+            for (const auto &entry : this->m_entries) {
+                auto children = (entry.get()->*childrenGetter)();
+                std::ranges::move(children, std::back_inserter(result));
+            }
+
+            return result;
+        }
+
+        struct LazyState {
+            struct CachedEntry {
+                std::shared_ptr<Pattern> pattern;
+                std::list<u64>::iterator position;
+            };
+
+            std::vector<LazyEntry> entries;
+            std::string typeName;
+            EntryMaterializer materializer;
+            std::vector<EntryModifier> modifiers;
+            size_t cacheLimit = 1;
+
+            // Only set for compact arrays
+            std::shared_ptr<Pattern> entryTemplate, highlightTemplate;
+            bool uniformStride = false;
+
+            // Indices of the loaded entries, most recently used one first
+            std::list<u64> recentlyUsed;
+            std::map<u64, CachedEntry> cache;
+        };
+
+        template<typename F>
+        void forEachLoadedEntry(F &&callback) {
+            for (const auto &entry : this->m_entries)
+                callback(entry);
+
+            if (this->m_lazy != nullptr) {
+                for (const auto &[index, cachedEntry] : this->m_lazy->cache)
+                    callback(cachedEntry.pattern);
+
+                if (this->m_lazy->entryTemplate != nullptr)
+                    callback(this->m_lazy->entryTemplate);
+                if (this->m_lazy->highlightTemplate != nullptr)
+                    callback(this->m_lazy->highlightTemplate);
+            }
+        }
+
+        [[nodiscard]] std::shared_ptr<Pattern> loadLazyEntry(u64 index) const {
+            auto &lazy = *this->m_lazy;
+            if (auto it = lazy.cache.find(index); it != lazy.cache.end()) {
+                lazy.recentlyUsed.splice(lazy.recentlyUsed.begin(), lazy.recentlyUsed, it->second.position);
+                return it->second.pattern;
+            }
+
+            const auto offset = lazy.entries[index].offset;
+
+            std::shared_ptr<Pattern> entry;
+            if (lazy.entryTemplate != nullptr) {
+                entry = lazy.entryTemplate->clone();
+                entry->setOffset(offset);
+            } else {
+                entry = lazy.materializer(*this, index, offset);
+            }
+
+            // Same setup as the evaluator does when it creates the entries of a regular array
+            entry->setArrayIndex(index);
+            entry->setEndian(this->getEndian());
+            entry->setParent(std::const_pointer_cast<Pattern>(this->shared_from_this()));
+            if (entry->getSection() == MainSectionId)
+                entry->setSection(this->getSection());
+            if (!entry->hasOverriddenColor())
+                entry->setBaseColor(this->getColor());
+            if (this->isReference())
+                entry->setReference(true);
+
+            for (const auto &modifier : lazy.modifiers)
+                modifier(entry);
+
+            lazy.recentlyUsed.push_front(index);
+            lazy.cache.insert({ index, { entry, lazy.recentlyUsed.begin() } });
+
+            while (lazy.cache.size() > lazy.cacheLimit) {
+                lazy.cache.erase(lazy.recentlyUsed.back());
+                lazy.recentlyUsed.pop_back();
+            }
+
+            return entry;
+        }
+
         std::vector<std::shared_ptr<Pattern>> m_entries;
+        std::unique_ptr<LazyState> m_lazy;
+    };
+
+    template<>
+    struct PatternKindOf<PatternArrayDynamic> {
+        constexpr static bool matches(PatternKind kind) { return kind == PatternKind::ArrayDynamic; }
     };
 
 }
\ No newline at end of file
@@ -9,14 +9,16 @@ namespace pl::ptrn {
                                public IIndexable {
     public:
         PatternArrayStatic(core::Evaluator *evaluator, u64 offset, size_t size, u32 line)
-            : Pattern(evaluator, offset, size, line) { }
+            : Pattern(evaluator, offset, size, line) {
+            this->setPatternKind(PatternKind::ArrayStatic);
+        }
 
         PatternArrayStatic(const PatternArrayStatic &other) : Pattern(other) {
             this->setEntries(other.getTemplate()->clone(), other.getEntryCount());
         }
 
         [[nodiscard]] std::shared_ptr<Pattern> clone() const override {
-            auto other = std::make_shared<PatternArrayStatic>(*this);
+            auto other = copyPattern(*this);
             other->m_template->setParent(other->reference());
             return other;
         }
@@ -65,6 +67,9 @@ namespace pl::ptrn {
         void setOffset(u64 offset) override {
             this->m_template->setOffset(this->m_template->getOffset() - this->getOffset() + offset);
 
+            if (this->m_highlightTemplate != nullptr)
+                this->m_highlightTemplate->setOffset(this->m_highlightTemplate->getOffset() - this->getOffset() + offset);
+
             Pattern::setOffset(offset);
         }
 
@@ -74,8 +79,8 @@ namespace pl::ptrn {
 
             this->m_template->setSection(id);
 
-            for (auto &highlightTemplate : this->m_highlightTemplates)
-                highlightTemplate->setSection(id);
+            if (this->m_highlightTemplate != nullptr)
+                this->m_highlightTemplate->setSection(id);
 
             Pattern::setSection(id);
         }
@@ -89,18 +94,17 @@ namespace pl::ptrn {
             else {
                 std::vector<std::pair<u64, Pattern*>> result;
 
-                std::shared_ptr<Pattern> highlightTemplate = this->m_template->clone();
+                // The highlight template may have been moved to another entry, so child addresses are taken relative to where it is now
+                const auto &highlightTemplate = this->getHighlightTemplate();
+                const auto templateOffset = highlightTemplate->getOffset();
 
-                highlightTemplate->setVariableName(this->getVariableName());
-                highlightTemplate->setOffset(this->getOffset());
-
-                const auto &children = this->m_highlightTemplates.emplace_back(std::move(highlightTemplate))->getChildren();
+                const auto children = highlightTemplate->getChildren();
                 result.reserve(this->getEntryCount() * children.size());
 
                 auto templateSize = this->m_template->getSize();
                 for (size_t i = 0; i < this->getEntryCount(); i++) {
                     for (const auto &[offset, child] : children) {
-                        result.emplace_back(offset + i * templateSize, child);
+                        result.emplace_back(offset - templateOffset + this->getOffset() + i * templateSize, child);
                     }
                 }
 
@@ -108,12 +112,31 @@ namespace pl::ptrn {
             }
         }
 
+        [[nodiscard]] std::vector<std::pair<u64, Pattern*>> getHighlightChildren() override {
+            if (this->getVisibility() == Visibility::HighlightHidden)
+                return { };
+
+            // Entries aren't expanded here. The runtime resolves addresses inside of the array arithmetically using the highlight template
+            return { { this->getOffset(), this } };
+        }
+
+        // Copy of the template used to highlight entries. It starts out at the first entry and gets moved to whichever entry is being looked at
+        [[nodiscard]] const std::shared_ptr<Pattern> &getHighlightTemplate() {
+            if (this->m_highlightTemplate == nullptr) {
+                this->m_highlightTemplate = this->m_template->clone();
+                this->m_highlightTemplate->setVariableName(this->getVariableName());
+                this->m_highlightTemplate->setOffset(this->getOffset());
+            }
+
+            return this->m_highlightTemplate;
+        }
+
         void setLocal(bool local) override {
             if (this->m_template != nullptr)
                 this->m_template->setLocal(local);
 
-            for (auto &highlightTemplate : this->m_highlightTemplates)
-                highlightTemplate->setLocal(local);
+            if (this->m_highlightTemplate != nullptr)
+                this->m_highlightTemplate->setLocal(local);
 
             Pattern::setLocal(local);
         }
@@ -122,8 +145,8 @@ namespace pl::ptrn {
             if (this->m_template != nullptr)
                 this->m_template->setReference(reference);
 
-            for (auto &highlightTemplate : this->m_highlightTemplates)
-                highlightTemplate->setReference(reference);
+            if (this->m_highlightTemplate != nullptr)
+                this->m_highlightTemplate->setReference(reference);
 
             Pattern::setReference(reference);
         }
@@ -132,8 +155,8 @@ namespace pl::ptrn {
             Pattern::setColor(color);
             this->m_template->setColor(color);
 
-            for (auto &highlightTemplate : this->m_highlightTemplates)
-                highlightTemplate->setColor(color);
+            if (this->m_highlightTemplate != nullptr)
+                this->m_highlightTemplate->setColor(color);
         }
 
         [[nodiscard]] std::string getFormattedName() const override {
@@ -163,15 +186,12 @@ namespace pl::ptrn {
             this->m_template          = std::move(templatePattern);
             if (!weak_from_this().expired())
                 this->m_template->setParent(this->reference());
-            this->m_highlightTemplates.push_back(this->m_template->clone());
+            this->m_highlightTemplate = nullptr;
             this->m_entryCount        = count;
 
             this->m_template->setSection(this->getSection());
 
             this->m_template->setBaseColor(this->getColor());
-
-            for (auto &highlightTemplate : this->m_highlightTemplates)
-                highlightTemplate->setBaseColor(this->getColor());
         }
 
         void setEntries(const std::vector<std::shared_ptr<Pattern>> &entries) override {
@@ -251,16 +271,21 @@ namespace pl::ptrn {
         void clearFormatCache() override {
             this->m_template->clearFormatCache();
 
-            for (auto &highlightTemplate : this->m_highlightTemplates)
-                highlightTemplate->clearFormatCache();
+            if (this->m_highlightTemplate != nullptr)
+                this->m_highlightTemplate->clearFormatCache();
 
             Pattern::clearFormatCache();
         }
 
     private:
         std::shared_ptr<Pattern> m_template = nullptr;
-        mutable std::vector<std::shared_ptr<Pattern>> m_highlightTemplates;
+        std::shared_ptr<Pattern> m_highlightTemplate = nullptr;
         size_t m_entryCount = 0;
     };
 
+    template<>
+    struct PatternKindOf<PatternArrayStatic> {
+        constexpr static bool matches(PatternKind kind) { return kind == PatternKind::ArrayStatic; }
+    };
+
 }
@@ -5,6 +5,53 @@
 
 namespace pl::ptrn {
 
+    class PatternBitfieldMember;
+    class PatternBitfieldField;
+    class PatternBitfieldFieldSigned;
+    class PatternBitfieldFieldBoolean;
+    class PatternBitfieldFieldEnum;
+    class PatternBitfieldArray;
+    class PatternBitfield;
+
+    template<>
+    struct PatternKindOf<PatternBitfieldMember> {
+        constexpr static bool matches(PatternKind kind) {
+            return kind == PatternKind::Bitfield || kind == PatternKind::BitfieldArray || PatternKindOf<PatternBitfieldField>::matches(kind);
+        }
+    };
+
+    template<>
+    struct PatternKindOf<PatternBitfieldField> {
+        constexpr static bool matches(PatternKind kind) {
+            return kind == PatternKind::BitfieldField || kind == PatternKind::BitfieldFieldSigned || kind == PatternKind::BitfieldFieldBoolean || kind == PatternKind::BitfieldFieldEnum;
+        }
+    };
+
+    template<>
+    struct PatternKindOf<PatternBitfieldFieldSigned> {
+        constexpr static bool matches(PatternKind kind) { return kind == PatternKind::BitfieldFieldSigned; }
+    };
+
+    template<>
+    struct PatternKindOf<PatternBitfieldFieldBoolean> {
+        constexpr static bool matches(PatternKind kind) { return kind == PatternKind::BitfieldFieldBoolean; }
+    };
+
+    template<>
+    struct PatternKindOf<PatternBitfieldFieldEnum> {
+        constexpr static bool matches(PatternKind kind) { return kind == PatternKind::BitfieldFieldEnum; }
+    };
+
+    template<>
+    struct PatternKindOf<PatternBitfieldArray> {
+        constexpr static bool matches(PatternKind kind) { return kind == PatternKind::BitfieldArray; }
+    };
+
+    template<>
+    struct PatternKindOf<PatternBitfield> {
+        constexpr static bool matches(PatternKind kind) { return kind == PatternKind::Bitfield; }
+    };
+
     class PatternBitfieldMember : public Pattern {
     public:
         using Pattern::Pattern;
@@ -12,7 +59,7 @@ namespace pl::ptrn {
         [[nodiscard]] const PatternBitfieldMember& getTopmostBitfield() const {
             const PatternBitfieldMember* topBitfield = this;
             while (auto parent = topBitfield->getParent()) {
-                auto parentBitfield = dynamic_cast<const PatternBitfieldMember*>(parent);
+                auto parentBitfield = pattern_cast<PatternBitfieldMember>(parent);
                 if (parentBitfield == nullptr)
                     break;
 
@@ -55,6 +102,8 @@ namespace pl::ptrn {
     public:
         PatternBitfieldField(core::Evaluator *evaluator, u64 offset, u8 bitOffset, u8 bitSize, u32 line, PatternBitfieldMember *parentBitfield = nullptr)
                 : PatternBitfieldMember(evaluator, offset, (bitOffset + bitSize + 7) / 8, line), m_bitOffset(bitOffset % 8), m_bitSize(bitSize) {
+            this->setPatternKind(PatternKind::BitfieldField);
+
             if (parentBitfield != nullptr)
                 this->setParent(parentBitfield->reference());
         }
@@ -66,7 +115,7 @@ namespace pl::ptrn {
         }
 
         [[nodiscard]] std::shared_ptr<Pattern> clone() const override {
-            return std::unique_ptr<Pattern>(new PatternBitfieldField(*this));
+            return copyPattern(*this);
         }
 
         [[nodiscard]] u128 readValue() const {
@@ -127,8 +176,8 @@ namespace pl::ptrn {
                 result = this->getBytesOf(value);
             } else {
                 try {
-                    const auto function = this->getEvaluator()->findFunction(formatterFunctionName);
-                    if (function.has_value()) {
+                    const auto function = this->getEvaluator()->getFunction(formatterFunctionName);
+                    if (function != nullptr) {
                         auto formatterResult = function->func(this->getEvaluator(), { value });
 
                         if (formatterResult.has_value()) {
@@ -160,10 +209,13 @@ namespace pl::ptrn {
 
     class PatternBitfieldFieldSigned : public PatternBitfieldField {
     public:
-        using PatternBitfieldField::PatternBitfieldField;
+        PatternBitfieldFieldSigned(core::Evaluator *evaluator, u64 offset, u8 bitOffset, u8 bitSize, u32 line, PatternBitfieldMember *parentBitfield = nullptr)
+                : PatternBitfieldField(evaluator, offset, bitOffset, bitSize, line, parentBitfield) {
+            this->setPatternKind(PatternKind::BitfieldFieldSigned);
+        }
 
         [[nodiscard]] std::shared_ptr<Pattern> clone() const override {
-            return std::unique_ptr<Pattern>(new PatternBitfieldFieldSigned(*this));
+            return copyPattern(*this);
         }
 
         [[nodiscard]] core::Token::Literal getValue() const override {
@@ -184,10 +236,13 @@ namespace pl::ptrn {
 
     class PatternBitfieldFieldBoolean : public PatternBitfieldField {
     public:
-        using PatternBitfieldField::PatternBitfieldField;
+        PatternBitfieldFieldBoolean(core::Evaluator *evaluator, u64 offset, u8 bitOffset, u8 bitSize, u32 line, PatternBitfieldMember *parentBitfield = nullptr)
+                : PatternBitfieldField(evaluator, offset, bitOffset, bitSize, line, parentBitfield) {
+            this->setPatternKind(PatternKind::BitfieldFieldBoolean);
+        }
 
         [[nodiscard]] std::shared_ptr<Pattern> clone() const override {
-            return std::unique_ptr<Pattern>(new PatternBitfieldFieldBoolean(*this));
+            return copyPattern(*this);
         }
 
         [[nodiscard]] core::Token::Literal getValue() const override {
@@ -216,7 +271,10 @@ namespace pl::ptrn {
 
     class PatternBitfieldFieldEnum : public PatternBitfieldField {
     public:
-        using PatternBitfieldField::PatternBitfieldField;
+        PatternBitfieldFieldEnum(core::Evaluator *evaluator, u64 offset, u8 bitOffset, u8 bitSize, u32 line, PatternBitfieldMember *parentBitfield = nullptr)
+                : PatternBitfieldField(evaluator, offset, bitOffset, bitSize, line, parentBitfield) {
+            this->setPatternKind(PatternKind::BitfieldFieldEnum);
+        }
 
         [[nodiscard]] std::string getFormattedName() const override {
             return "enum " + Pattern::getTypeName();
@@ -242,7 +300,7 @@ namespace pl::ptrn {
         }
 
         [[nodiscard]] std::shared_ptr<Pattern> clone() const override {
-            return std::unique_ptr<Pattern>(new PatternBitfieldFieldEnum(*this));
+            return copyPattern(*this);
         }
 
         std::string formatDisplayValue() override {
@@ -265,7 +323,9 @@ namespace pl::ptrn {
                                  public IIndexable {
     public:
         PatternBitfieldArray(core::Evaluator *evaluator, u64 offset, u8 firstBitOffset, u128 totalBitSize, u32 line)
-                : PatternBitfieldMember(evaluator, offset, size_t((totalBitSize + 7) / 8), line), m_firstBitOffset(firstBitOffset), m_totalBitSize(totalBitSize) { }
+                : PatternBitfieldMember(evaluator, offset, size_t((totalBitSize + 7) / 8), line), m_firstBitOffset(firstBitOffset), m_totalBitSize(totalBitSize) {
+            this->setPatternKind(PatternKind::BitfieldArray);
+        }
 
         PatternBitfieldArray(const PatternBitfieldArray &other) : PatternBitfieldMember(other) {
             std::vector<std::shared_ptr<Pattern>> entries;
@@ -279,7 +339,7 @@ namespace pl::ptrn {
         }
 
         [[nodiscard]] std::shared_ptr<Pattern> clone() const override {
-            auto other =  std::make_shared<PatternBitfieldArray>(*this);
+            auto other = copyPattern(*this);
             for (const auto &entry : other->m_entries)
                 entry->setParent(other->reference());
             return other;
@@ -410,7 +470,7 @@ namespace pl::ptrn {
                 evaluator->setCurrentArrayIndex(i);
 
                 auto &entry = patterns[i];
-                if (!entry->isPatternLocal() || entry->hasAttribute("export"))
+                if (!entry->isPatternLocal() || entry->isExported())
                     fn(i, entry);
             }
         }
@@ -542,7 +602,9 @@ namespace pl::ptrn {
                             public IIterable {
     public:
         PatternBitfield(core::Evaluator *evaluator, u64 offset, u8 firstBitOffset, u128 totalBitSize, u32 line)
-                : PatternBitfieldMember(evaluator, offset, size_t((totalBitSize + 7) / 8), line), m_firstBitOffset(firstBitOffset), m_totalBitSize(totalBitSize) { }
+                : PatternBitfieldMember(evaluator, offset, size_t((totalBitSize + 7) / 8), line), m_firstBitOffset(firstBitOffset), m_totalBitSize(totalBitSize) {
+            this->setPatternKind(PatternKind::Bitfield);
+        }
 
         PatternBitfield(const PatternBitfield &other) : PatternBitfieldMember(other) {
             for (const auto &field : other.m_fields)
@@ -553,7 +615,7 @@ namespace pl::ptrn {
         }
 
         [[nodiscard]] std::shared_ptr<Pattern> clone() const override {
-            return std::unique_ptr<Pattern>(new PatternBitfield(*this));
+            return copyPattern(*this);
         }
 
         [[nodiscard]] u8 getBitOffset() const override {
@@ -703,7 +765,7 @@ namespace pl::ptrn {
             std::string valueString;
 
             for (const auto &pattern : this->m_fields) {
-                if (auto *field = dynamic_cast<PatternBitfieldField *>(pattern.get()); field != nullptr) {
+                if (auto *field = pattern_cast<PatternBitfieldField>(pattern.get()); field != nullptr) {
                     auto fieldValue = field->getValue().toUnsigned();
 
                     if (field->getBitSize() == 1) {
@@ -712,9 +774,9 @@ namespace pl::ptrn {
                     } else {
                         valueString += fmt::format("{}({}) | ", field->getVariableName(), field->toString());
                     }
-                } else if (auto *member = dynamic_cast<PatternBitfieldMember *>(pattern.get()); member != nullptr) {
+                } else if (auto *member = pattern_cast<PatternBitfieldMember>(pattern.get()); member != nullptr) {
                     valueString += fmt::format("{} = {} | ", member->getVariableName(), member->toString());
-                } else if (auto *bitfield = dynamic_cast<PatternBitfield *>(pattern.get()); bitfield != nullptr) {
+                } else if (auto *bitfield = pattern_cast<PatternBitfield>(pattern.get()); bitfield != nullptr) {
                     valueString += fmt::format("{} = {} | ", bitfield->getVariableName(), bitfield->formatDisplayValue());
                 }
             }
@@ -773,7 +835,7 @@ namespace pl::ptrn {
 
             for (auto i = start; i < end; i++) {
                 auto &pattern = patterns[i];
-                if (!pattern->isPatternLocal() || pattern->hasAttribute("export"))
+                if (!pattern->isPatternLocal() || pattern->isExported())
                     fn(i, pattern);
             }
         }
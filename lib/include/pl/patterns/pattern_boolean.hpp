@@ -7,10 +7,12 @@ namespace pl::ptrn {
     class PatternBoolean : public Pattern {
     public:
         explicit PatternBoolean(core::Evaluator *evaluator, u64 offset, u32 line)
-            : Pattern(evaluator, offset, 1, line) { }
+            : Pattern(evaluator, offset, 1, line) {
+            this->setPatternKind(PatternKind::Boolean);
+        }
 
         [[nodiscard]] std::shared_ptr<Pattern> clone() const override {
-            return std::unique_ptr<Pattern>(new PatternBoolean(*this));
+            return copyPattern(*this);
         }
 
         [[nodiscard]] core::Token::Literal getValue() const override {
@@ -65,4 +67,9 @@ namespace pl::ptrn {
         }
     };
 
+    template<>
+    struct PatternKindOf<PatternBoolean> {
+        constexpr static bool matches(PatternKind kind) { return kind == PatternKind::Boolean; }
+    };
+
 }
\ No newline at end of file
@@ -7,10 +7,12 @@ namespace pl::ptrn {
     class PatternCharacter : public Pattern {
     public:
         PatternCharacter(core::Evaluator *evaluator, u64 offset, u32 line)
-            : Pattern(evaluator, offset, 1, line) { }
+            : Pattern(evaluator, offset, 1, line) {
+            this->setPatternKind(PatternKind::Character);
+        }
 
         [[nodiscard]] std::shared_ptr<Pattern> clone() const override {
-            return std::make_unique<PatternCharacter>(*this);
+            return copyPattern(*this);
         }
 
         [[nodiscard]] core::Token::Literal getValue() const override {
@@ -61,4 +63,9 @@ namespace pl::ptrn {
         }
     };
 
+    template<>
+    struct PatternKindOf<PatternCharacter> {
+        constexpr static bool matches(PatternKind kind) { return kind == PatternKind::Character; }
+    };
+
 }
\ No newline at end of file
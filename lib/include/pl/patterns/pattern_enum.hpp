@@ -15,10 +15,12 @@ namespace pl::ptrn {
 
     public:
         PatternEnum(core::Evaluator *evaluator, u64 offset, size_t size, u32 line)
-            : Pattern(evaluator, offset, size, line) { }
+            : Pattern(evaluator, offset, size, line) {
+            this->setPatternKind(PatternKind::Enum);
+        }
 
         [[nodiscard]] std::shared_ptr<Pattern> clone() const override {
-            return std::unique_ptr<Pattern>(new PatternEnum(*this));
+            return copyPattern(*this);
         }
 
         [[nodiscard]] core::Token::Literal getValue() const override {
@@ -100,4 +102,9 @@ namespace pl::ptrn {
         std::map<std::string, EnumValue> m_enumValues;
     };
 
+    template<>
+    struct PatternKindOf<PatternEnum> {
+        constexpr static bool matches(PatternKind kind) { return kind == PatternKind::Enum; }
+    };
+
 }
\ No newline at end of file
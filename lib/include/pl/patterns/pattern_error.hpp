@@ -7,10 +7,12 @@ namespace pl::ptrn {
     class PatternError : public Pattern {
     public:
         PatternError(core::Evaluator *evaluator, u64 offset, size_t size, u32 line, std::string errorMessage)
-            : Pattern(evaluator, offset, size, line), m_errorMessage(std::move(errorMessage)) { }
+            : Pattern(evaluator, offset, size, line), m_errorMessage(std::move(errorMessage)) {
+            this->setPatternKind(PatternKind::Error);
+        }
 
         [[nodiscard]] std::shared_ptr<Pattern> clone() const override {
-            return std::unique_ptr<Pattern>(new PatternError(*this));
+            return copyPattern(*this);
         }
 
         [[nodiscard]] std::string getFormattedName() const override {
@@ -43,4 +45,9 @@ namespace pl::ptrn {
         std::string m_errorMessage;
     };
 
+    template<>
+    struct PatternKindOf<PatternError> {
+        constexpr static bool matches(PatternKind kind) { return kind == PatternKind::Error; }
+    };
+
 }
\ No newline at end of file
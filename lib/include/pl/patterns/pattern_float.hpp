@@ -7,10 +7,12 @@ namespace pl::ptrn {
     class PatternFloat : public Pattern {
     public:
         PatternFloat(core::Evaluator *evaluator, u64 offset, size_t size, u32 line)
-            : Pattern(evaluator, offset, size, line) { }
+            : Pattern(evaluator, offset, size, line) {
+            this->setPatternKind(PatternKind::Float);
+        }
 
         [[nodiscard]] std::shared_ptr<Pattern> clone() const override {
-            return std::unique_ptr<Pattern>(new PatternFloat(*this));
+            return copyPattern(*this);
         }
 
         [[nodiscard]] core::Token::Literal getValue() const override {
@@ -105,4 +107,9 @@ namespace pl::ptrn {
         }
     };
 
+    template<>
+    struct PatternKindOf<PatternFloat> {
+        constexpr static bool matches(PatternKind kind) { return kind == PatternKind::Float; }
+    };
+
 }
\ No newline at end of file
@@ -6,10 +6,12 @@ namespace pl::ptrn {
 
     class PatternPadding : public Pattern {
     public:
-        PatternPadding(core::Evaluator *evaluator, u64 offset, size_t size, u32 line) : Pattern(evaluator, offset, size, line) { }
+        PatternPadding(core::Evaluator *evaluator, u64 offset, size_t size, u32 line) : Pattern(evaluator, offset, size, line) {
+            this->setPatternKind(PatternKind::Padding);
+        }
 
         [[nodiscard]] std::shared_ptr<Pattern> clone() const override {
-            return std::unique_ptr<Pattern>(new PatternPadding(*this));
+            return copyPattern(*this);
         }
 
         [[nodiscard]] std::string getFormattedName() const override {
@@ -46,4 +48,9 @@ namespace pl::ptrn {
         }
     };
 
+    template<>
+    struct PatternKindOf<PatternPadding> {
+        constexpr static bool matches(PatternKind kind) { return kind == PatternKind::Padding; }
+    };
+
 }
\ No newline at end of file
@@ -10,6 +10,7 @@ namespace pl::ptrn {
     public:
         PatternPointer(core::Evaluator *evaluator, u64 offset, size_t size, u32 line)
             : Pattern(evaluator, offset, size, line), m_pointedAt(nullptr), m_pointerType(nullptr) {
+            this->setPatternKind(PatternKind::Pointer);
         }
 
         PatternPointer(const PatternPointer &other) : Pattern(other) {
@@ -21,7 +22,7 @@ namespace pl::ptrn {
         }
 
         [[nodiscard]] std::shared_ptr<Pattern> clone() const override {
-            return std::unique_ptr<Pattern>(new PatternPointer(*this));
+            return copyPattern(*this);
         }
 
         [[nodiscard]] core::Token::Literal getValue() const override {
@@ -52,6 +53,15 @@ namespace pl::ptrn {
             return children;
         }
 
+        [[nodiscard]] std::vector<std::pair<u64, Pattern*>> getHighlightChildren() override {
+            if (this->getVisibility() == Visibility::HighlightHidden)
+                return { };
+
+            auto children = this->m_pointedAt->getHighlightChildren();
+            children.emplace_back(this->getOffset(), this);
+            return children;
+        }
+
         void setSection(u64 id) override {
             if (this->getSection() == id)
                 return;
@@ -183,4 +193,9 @@ namespace pl::ptrn {
         u64 m_pointerBase = 0;
     };
 
+    template<>
+    struct PatternKindOf<PatternPointer> {
+        constexpr static bool matches(PatternKind kind) { return kind == PatternKind::Pointer; }
+    };
+
 }
@@ -7,10 +7,12 @@ namespace pl::ptrn {
     class PatternSigned : public Pattern {
     public:
         PatternSigned(core::Evaluator *evaluator, u64 offset, size_t size, u32 line)
-            : Pattern(evaluator, offset, size, line) { }
+            : Pattern(evaluator, offset, size, line) {
+            this->setPatternKind(PatternKind::Signed);
+        }
 
         [[nodiscard]] std::shared_ptr<Pattern> clone() const override {
-            return std::unique_ptr<Pattern>(new PatternSigned(*this));
+            return copyPattern(*this);
         }
 
         [[nodiscard]] core::Token::Literal getValue() const override {
@@ -56,4 +58,9 @@ namespace pl::ptrn {
         }
     };
 
+    template<>
+    struct PatternKindOf<PatternSigned> {
+        constexpr static bool matches(PatternKind kind) { return kind == PatternKind::Signed; }
+    };
+
 }
\ No newline at end of file
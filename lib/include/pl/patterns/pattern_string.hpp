@@ -10,10 +10,12 @@ namespace pl::ptrn {
                           public IIndexable {
     public:
         PatternString(core::Evaluator *evaluator, u64 offset, size_t size, u32 line)
-            : Pattern(evaluator, offset, size, line) { }
+            : Pattern(evaluator, offset, size, line) {
+            this->setPatternKind(PatternKind::String);
+        }
 
         [[nodiscard]] std::shared_ptr<Pattern> clone() const override {
-            return std::unique_ptr<Pattern>(new PatternString(*this));
+            return copyPattern(*this);
         }
 
         [[nodiscard]] core::Token::Literal getValue() const override {
@@ -80,7 +82,7 @@ namespace pl::ptrn {
         }
 
         std::shared_ptr<Pattern> getEntry(size_t index) const override {
-            auto result = std::make_shared<PatternCharacter>(this->getEvaluator(), this->getOffset() + index, getLine());
+            auto result = this->getEvaluator()->createPattern<PatternCharacter>(this->getOffset() + index, getLine());
             result->setVariableName(fmt::format("{}[{}]", this->getVariableName(), index));
             result->setSection(this->getSection());
 
@@ -111,4 +113,9 @@ namespace pl::ptrn {
 
     };
 
+    template<>
+    struct PatternKindOf<PatternString> {
+        constexpr static bool matches(PatternKind kind) { return kind == PatternKind::String; }
+    };
+
 }
\ No newline at end of file
@@ -9,7 +9,9 @@ namespace pl::ptrn {
                           public IIterable {
     public:
         PatternStruct(core::Evaluator *evaluator, u64 offset, size_t size, u32 line)
-            : Pattern(evaluator, offset, size, line) { }
+            : Pattern(evaluator, offset, size, line) {
+            this->setPatternKind(PatternKind::Struct);
+        }
 
         PatternStruct(const PatternStruct &other) : Pattern(other) {
             for (const auto &member : other.m_members) {
@@ -21,7 +23,7 @@ namespace pl::ptrn {
         }
 
         [[nodiscard]] std::shared_ptr<Pattern> clone() const override {
-            auto other = std::make_shared<PatternStruct>(*this);
+            auto other = copyPattern(*this);
             for (const auto &member : other->m_members)
                 member->setParent(other->reference());
 
@@ -64,7 +66,7 @@ namespace pl::ptrn {
 
             for (u64 i = start; i < patterns.size() && i < end; i++) {
                 auto &pattern = patterns[i];
-                if (!pattern->isPatternLocal() || pattern->hasAttribute("export"))
+                if (!pattern->isPatternLocal() || pattern->isExported())
                     fn(i, pattern);
             }
         }
@@ -93,22 +95,11 @@ namespace pl::ptrn {
         }
 
         [[nodiscard]] std::vector<std::pair<u64, Pattern*>> getChildren() override {
-            if (this->getVisibility() == Visibility::HighlightHidden)
-                return { };
-
-            if (this->isSealed())
-                return { { this->getOffset(), this } };
-            else {
-                std::vector<std::pair<u64, Pattern*>> result;
-
-                for (const auto &member : this->m_members) {
-                    auto children = member->getChildren();
-                    result.reserve(result.size() + children.size());
-                    std::move(children.begin(), children.end(), std::back_inserter(result));
-                }
+            return this->getMemberChildren(&Pattern::getChildren);
+        }
 
-                return result;
-            }
+        [[nodiscard]] std::vector<std::pair<u64, Pattern*>> getHighlightChildren() override {
+            return this->getMemberChildren(&Pattern::getHighlightChildren);
         }
 
         void setLocal(bool local) override {
@@ -232,8 +223,32 @@ namespace pl::ptrn {
         }
 
     private:
+        [[nodiscard]] std::vector<std::pair<u64, Pattern*>> getMemberChildren(ChildrenGetter childrenGetter) {
+            if (this->getVisibility() == Visibility::HighlightHidden)
+                return { };
+
+            if (this->isSealed())
+                return { { this->getOffset(), this } };
+            else {
+                std::vector<std::pair<u64, Pattern*>> result;
+
+                for (const auto &member : this->m_members) {
+                    auto children = (member.get()->*childrenGetter)();
+                    result.reserve(result.size() + children.size());
+                    std::move(children.begin(), children.end(), std::back_inserter(result));
+                }
+
+                return result;
+            }
+        }
+
         std::vector<std::shared_ptr<Pattern>> m_members;
         std::vector<std::shared_ptr<Pattern>> m_sortedMembers;
     };
 
+    template<>
+    struct PatternKindOf<PatternStruct> {
+        constexpr static bool matches(PatternKind kind) { return kind == PatternKind::Struct; }
+    };
+
 }
\ No newline at end of file
@@ -9,7 +9,9 @@ namespace pl::ptrn {
                          public IIterable {
     public:
         PatternUnion(core::Evaluator *evaluator, u64 offset, size_t size, u32 line)
-            : Pattern(evaluator, offset, size, line) { }
+            : Pattern(evaluator, offset, size, line) {
+            this->setPatternKind(PatternKind::Union);
+        }
 
         PatternUnion(const PatternUnion &other) : Pattern(other) {
             for (const auto &member : other.m_members) {
@@ -20,7 +22,7 @@ namespace pl::ptrn {
         }
 
         [[nodiscard]] std::shared_ptr<Pattern> clone() const override {
-            auto other = std::make_shared<PatternUnion>(*this);
+            auto other = copyPattern(*this);
             for (const auto &member : other->m_members)
                 member->setParent(other->reference());
 
@@ -62,7 +64,7 @@ namespace pl::ptrn {
 
             for (u64 i = start; i < patterns.size() && i < end; i++) {
                 auto &pattern = patterns[i];
-                if (!pattern->isPatternLocal() || pattern->hasAttribute("export"))
+                if (!pattern->isPatternLocal() || pattern->isExported())
                     fn(i, pattern);
             }
         }
@@ -91,22 +93,11 @@ namespace pl::ptrn {
         }
 
         [[nodiscard]] std::vector<std::pair<u64, Pattern*>> getChildren() override {
-            if (this->getVisibility() == Visibility::HighlightHidden)
-                return { };
-
-            if (this->isSealed())
-                return { { this->getOffset(), this } };
-            else {
-                std::vector<std::pair<u64, Pattern*>> result;
-
-                for (const auto &member : this->m_members) {
-                    auto children = member->getChildren();
-                    result.reserve(result.size() + children.size());
-                    std::move(children.begin(), children.end(), std::back_inserter(result));
-                }
+            return this->getMemberChildren(&Pattern::getChildren);
+        }
 
-                return result;
-            }
+        [[nodiscard]] std::vector<std::pair<u64, Pattern*>> getHighlightChildren() override {
+            return this->getMemberChildren(&Pattern::getHighlightChildren);
         }
 
         void setLocal(bool local) override {
@@ -223,8 +214,32 @@ namespace pl::ptrn {
         }
 
     private:
+        [[nodiscard]] std::vector<std::pair<u64, Pattern*>> getMemberChildren(ChildrenGetter childrenGetter) {
+            if (this->getVisibility() == Visibility::HighlightHidden)
+                return { };
+
+            if (this->isSealed())
+                return { { this->getOffset(), this } };
+            else {
+                std::vector<std::pair<u64, Pattern*>> result;
+
+                for (const auto &member : this->m_members) {
+                    auto children = (member.get()->*childrenGetter)();
+                    result.reserve(result.size() + children.size());
+                    std::move(children.begin(), children.end(), std::back_inserter(result));
+                }
+
+                return result;
+            }
+        }
+
         std::vector<std::shared_ptr<Pattern>> m_members;
         std::vector<std::shared_ptr<Pattern>> m_sortedMembers;
     };
 
+    template<>
+    struct PatternKindOf<PatternUnion> {
+        constexpr static bool matches(PatternKind kind) { return kind == PatternKind::Union; }
+    };
+
 }
\ No newline at end of file
@@ -7,10 +7,12 @@ namespace pl::ptrn {
     class PatternUnsigned : public Pattern {
     public:
         PatternUnsigned(core::Evaluator *evaluator, u64 offset, size_t size, u32 line)
-            : Pattern(evaluator, offset, size, line) { }
+            : Pattern(evaluator, offset, size, line) {
+            this->setPatternKind(PatternKind::Unsigned);
+        }
 
         [[nodiscard]] std::shared_ptr<Pattern> clone() const override {
-            return std::unique_ptr<Pattern>(new PatternUnsigned(*this));
+            return copyPattern(*this);
         }
 
         [[nodiscard]] core::Token::Literal getValue() const override {
@@ -53,4 +55,9 @@ namespace pl::ptrn {
         }
     };
 
+    template<>
+    struct PatternKindOf<PatternUnsigned> {
+        constexpr static bool matches(PatternKind kind) { return kind == PatternKind::Unsigned; }
+    };
+
 }
\ No newline at end of file
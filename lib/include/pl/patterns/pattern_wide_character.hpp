@@ -9,10 +9,12 @@ namespace pl::ptrn {
     class PatternWideCharacter : public Pattern {
     public:
         explicit PatternWideCharacter(core::Evaluator *evaluator, u64 offset, u32 line)
-            : Pattern(evaluator, offset, 2, line) { }
+            : Pattern(evaluator, offset, 2, line) {
+            this->setPatternKind(PatternKind::WideCharacter);
+        }
 
         [[nodiscard]] std::shared_ptr<Pattern> clone() const override {
-            return std::unique_ptr<Pattern>(new PatternWideCharacter(*this));
+            return copyPattern(*this);
         }
 
         [[nodiscard]] core::Token::Literal getValue() const override {
@@ -57,4 +59,9 @@ namespace pl::ptrn {
         }
     };
 
+    template<>
+    struct PatternKindOf<PatternWideCharacter> {
+        constexpr static bool matches(PatternKind kind) { return kind == PatternKind::WideCharacter; }
+    };
+
 }
@@ -10,10 +10,12 @@ namespace pl::ptrn {
                               public IIndexable {
     public:
         PatternWideString(core::Evaluator *evaluator, u64 offset, size_t size, u32 line)
-            : Pattern(evaluator, offset, size, line) { }
+            : Pattern(evaluator, offset, size, line) {
+            this->setPatternKind(PatternKind::WideString);
+        }
 
         [[nodiscard]] std::shared_ptr<Pattern> clone() const override {
-            return std::unique_ptr<Pattern>(new PatternWideString(*this));
+            return copyPattern(*this);
         }
 
         [[nodiscard]] core::Token::Literal getValue() const override {
@@ -84,7 +86,7 @@ namespace pl::ptrn {
         }
 
         std::shared_ptr<Pattern> getEntry(size_t index) const override {
-            auto result = std::make_shared<PatternWideCharacter>(this->getEvaluator(), this->getOffset() + index * sizeof(char16_t), getLine());
+            auto result = this->getEvaluator()->createPattern<PatternWideCharacter>(this->getOffset() + index * sizeof(char16_t), getLine());
             result->setSection(this->getSection());
 
             return result;
@@ -113,4 +115,9 @@ namespace pl::ptrn {
         }
     };
 
+    template<>
+    struct PatternKindOf<PatternWideString> {
+        constexpr static bool matches(PatternKind kind) { return kind == PatternKind::WideString; }
+    };
+
 }
@@ -15,11 +15,52 @@
 #include <pl/patterns/pattern_wide_string.hpp>
 #include <pl/patterns/pattern_array_dynamic.hpp>
 #include <pl/patterns/pattern_array_static.hpp>
+#include <pl/patterns/pattern_error.hpp>
 
 namespace pl::core::ast {
 
+    namespace {
+
+        // Pattern comparisons ignore colors and only compare attributes if both patterns have some, so check these for the whole tree
+        bool hasSameProperties(const ptrn::Pattern &first, const ptrn::Pattern &second) {
+            if (first.hasOverriddenColor() != second.hasOverriddenColor())
+                return false;
+            if (first.hasOverriddenColor() && first.getColor() != second.getColor())
+                return false;
+
+            const auto firstAttributes = first.getAttributes(), secondAttributes = second.getAttributes();
+            if ((firstAttributes == nullptr) != (secondAttributes == nullptr))
+                return false;
+            if (firstAttributes != nullptr && *firstAttributes != *secondAttributes)
+                return false;
+
+            // Characters of strings are created from the string itself and can't be changed
+            if (first.getPatternKind() == ptrn::PatternKind::String || first.getPatternKind() == ptrn::PatternKind::WideString)
+                return true;
+
+            const auto firstIterable = dynamic_cast<const ptrn::IIterable*>(&first), secondIterable = dynamic_cast<const ptrn::IIterable*>(&second);
+            if (firstIterable == nullptr || secondIterable == nullptr)
+                return firstIterable == secondIterable;
+            if (firstIterable->getEntryCount() != secondIterable->getEntryCount())
+                return false;
+
+            for (size_t i = 0; i < firstIterable->getEntryCount(); i++) {
+                if (!hasSameProperties(*firstIterable->getEntry(i), *secondIterable->getEntry(i)))
+                    return false;
+            }
+
+            return true;
+        }
+
+        // Entries are interchangeable if moving one of them to the offset of the other one makes them equal
+        bool isSameLayout(const ptrn::Pattern &movedEntry, const ptrn::Pattern &entry) {
+            return movedEntry == entry && hasSameProperties(movedEntry, entry);
+        }
+
+    }
+
     ASTNodeArrayVariableDecl::ASTNodeArrayVariableDecl(std::string name, std::shared_ptr<ASTNodeTypeApplication> type, std::unique_ptr<ASTNode> &&size, std::unique_ptr<ASTNode> &&placementOffset, std::unique_ptr<ASTNode> &&placementSection, bool constant)
-        :m_name(std::move(name)), m_type(std::move(type)), m_size(std::move(size)), m_placementOffset(std::move(placementOffset)), m_placementSection(std::move(placementSection)), m_constant(constant) { }
+        :ASTNode(Kind::ArrayVariableDecl), m_name(std::move(name)), m_type(std::move(type)), m_size(std::move(size)), m_placementOffset(std::move(placementOffset)), m_placementSection(std::move(placementSection)), m_constant(constant) { }
 
     ASTNodeArrayVariableDecl::ASTNodeArrayVariableDecl(const ASTNodeArrayVariableDecl &other) : ASTNode(other), Attributable(other) {
         this->m_name = other.m_name;
@@ -86,6 +127,10 @@ namespace pl::core::ast {
                 if (auto attributable = dynamic_cast<const Attributable *>(type))
                     isStaticType = attributable->hasAttribute("static", false);
 
+                // Arrays of types whose layout doesn't depend on the data are treated as if they were marked as static
+                if (!isStaticType)
+                    isStaticType = this->hasStaticEntryLayout(evaluator);
+
                 if (isStaticType)
                     createStaticArray(evaluator, pattern);
                 else
@@ -152,6 +197,17 @@ namespace pl::core::ast {
     }
 
 
+    bool ASTNodeArrayVariableDecl::hasStaticEntryLayout(Evaluator *evaluator) const {
+        if (!this->m_type->getTemplateArguments().empty() || this->m_type->isReference())
+            return false;
+
+        const auto typeDecl = dynamic_cast<const ASTNodeTypeDecl *>(this->m_type->getType().get());
+        if (typeDecl == nullptr || !typeDecl->getStaticLayout().has_value())
+            return false;
+
+        return evaluator->canUseLayoutTemplates();
+    }
+
     void ASTNodeArrayVariableDecl::createStaticArray(Evaluator *evaluator, std::shared_ptr<ptrn::Pattern> &outputPattern) const {
         evaluator->alignToByte();
         auto startOffset = evaluator->getReadOffset();
@@ -217,14 +273,14 @@ namespace pl::core::ast {
             }
         }
 
-        if (dynamic_cast<ptrn::PatternPadding *>(templatePattern.get())) {
+        if (ptrn::pattern_cast<ptrn::PatternPadding>(templatePattern.get())) {
             outputPattern = std::make_unique<ptrn::PatternPadding>(evaluator, startOffset, 0, getLocation().line);
-        } else if (dynamic_cast<ptrn::PatternCharacter *>(templatePattern.get())) {
+        } else if (ptrn::pattern_cast<ptrn::PatternCharacter>(templatePattern.get())) {
             outputPattern = std::make_unique<ptrn::PatternString>(evaluator, startOffset, 0, getLocation().line);
-        } else if (dynamic_cast<ptrn::PatternWideCharacter *>(templatePattern.get())) {
+        } else if (ptrn::pattern_cast<ptrn::PatternWideCharacter>(templatePattern.get())) {
             outputPattern = std::make_unique<ptrn::PatternWideString>(evaluator, startOffset, 0, getLocation().line);
         } else {
-            auto arrayPattern = std::make_shared<ptrn::PatternArrayStatic>(evaluator, startOffset, 0, getLocation().line);
+            auto arrayPattern = evaluator->createPattern<ptrn::PatternArrayStatic>(startOffset, 0, getLocation().line);
             templatePattern->setParent(arrayPattern);
             arrayPattern->setEntries(templatePattern->clone(), size_t(entryCount));
             arrayPattern->setSection(templatePattern->getSection());
@@ -247,6 +303,87 @@ namespace pl::core::ast {
                 err::E0004.throwError("Array expanded past end of the data.", { }, this->getLocation());
     }
 
+    ptrn::PatternArrayDynamic::EntryMaterializer ASTNodeArrayVariableDecl::createEntryMaterializer(Evaluator *evaluator) const {
+        return [evaluator, evaluationId = evaluator->getEvaluationId(), type = this->m_type, section = evaluator->getSectionId(), line = this->getLocation().line](const ptrn::Pattern &array, u64 index, u64 offset) -> std::shared_ptr<ptrn::Pattern> {
+            // The sections and variables the entry was created from are gone once the next run started
+            if (evaluator->getEvaluationId() != evaluationId)
+                return evaluator->createPattern<ptrn::PatternError>(offset, 0, line, "Array entry cannot be recreated after the pattern was evaluated again");
+
+            // Entries may be accessed in the middle of evaluating something else, so leave the evaluator the way it was
+            const auto readOffset = evaluator->getBitwiseReadOffset();
+            const auto arrayIndex = evaluator->getCurrentArrayIndex();
+            const auto controlFlow = evaluator->getCurrentControlFlowStatement();
+
+            evaluator->pushSectionId(section);
+            ON_SCOPE_EXIT {
+                evaluator->popSectionId();
+                evaluator->setBitwiseReadOffset(readOffset);
+                evaluator->setCurrentControlFlowStatement(controlFlow);
+
+                if (arrayIndex.has_value())
+                    evaluator->setCurrentArrayIndex(*arrayIndex);
+                else
+                    evaluator->clearCurrentArrayIndex();
+            };
+
+            evaluator->setBitwiseReadOffset(offset, 0);
+            evaluator->setCurrentArrayIndex(index);
+
+            try {
+                const auto isEntered = [evaluator](const ptrn::Pattern *pattern) {
+                    for (size_t i = 0; i < evaluator->getScopeCount(); i++) {
+                        if (evaluator->getScope(-i32(i)).parent.get() == pattern)
+                            return true;
+                    }
+
+                    return false;
+                };
+
+                // Entries can refer to the types the array is part of through 'parent', so enter their scopes again like while the array was created.
+                // Arrays accessed while their parent is still being evaluated already have the scopes of the rest of their ancestors on the stack
+                std::vector<std::shared_ptr<ptrn::Pattern>> ancestors;
+                for (auto ancestor = array.getParent(); ancestor != nullptr && !isEntered(ancestor); ancestor = ancestor->getParent()) {
+                    switch (ancestor->getPatternKind()) {
+                        case ptrn::PatternKind::Struct:
+                        case ptrn::PatternKind::Union:
+                        case ptrn::PatternKind::Bitfield:
+                            ancestors.push_back(std::const_pointer_cast<ptrn::Pattern>(ancestor->shared_from_this()));
+                            break;
+                        default:
+                            break;
+                    }
+                }
+
+                // Scopes point to their list of patterns, so these must not move while they're pushed
+                std::vector<std::vector<std::shared_ptr<ptrn::Pattern>>> scopePatterns(ancestors.size());
+                size_t pushedScopes = 0;
+                ON_SCOPE_EXIT {
+                    for (size_t i = 0; i < pushedScopes; i++)
+                        evaluator->popScope();
+                };
+
+                for (size_t i = ancestors.size(); i > 0; i--) {
+                    const auto &ancestor = ancestors[i - 1];
+                    if (auto iterable = dynamic_cast<ptrn::IIterable*>(ancestor.get()); iterable != nullptr)
+                        scopePatterns[i - 1] = iterable->getEntries();
+
+                    evaluator->pushScope(ancestor, scopePatterns[i - 1]);
+                    pushedScopes += 1;
+                }
+
+                std::vector<std::shared_ptr<ptrn::Pattern>> patterns;
+                type->createPatterns(evaluator, patterns);
+
+                if (!patterns.empty())
+                    return std::move(patterns.front());
+            } catch (const std::exception &e) {
+                return evaluator->createPattern<ptrn::PatternError>(offset, 0, line, e.what());
+            }
+
+            return evaluator->createPattern<ptrn::PatternError>(offset, 0, line, "Array entry could not be recreated");
+        };
+    }
+
     void ASTNodeArrayVariableDecl::createDynamicArray(Evaluator *evaluator, std::shared_ptr<ptrn::Pattern> &resultPattern) const {
         auto startArrayIndex = evaluator->getCurrentArrayIndex();
         ON_SCOPE_EXIT {
@@ -257,12 +394,21 @@ namespace pl::core::ast {
         };
 
         evaluator->alignToByte();
-        auto arrayPattern = std::make_shared<ptrn::PatternArrayDynamic>(evaluator, evaluator->getReadOffset(), 0, getLocation().line);
+        auto arrayPattern = evaluator->createPattern<ptrn::PatternArrayDynamic>(evaluator->getReadOffset(), 0, getLocation().line);
         arrayPattern->setVariableName(this->m_name);
         arrayPattern->setSection(evaluator->getSectionId());
 
         std::vector<std::shared_ptr<ptrn::Pattern>> entries;
 
+        // Lazy arrays only remember where their entries are and create them again once they're accessed
+        const bool lazy = this->hasAttribute("lazy", false);
+        std::vector<ptrn::PatternArrayDynamic::LazyEntry> lazyEntries;
+        std::string lazyTypeName;
+
+        // Compact arrays only store the locations of their entries as well, as long as all of them are copies of the first one at a different offset
+        bool compact = !lazy && this->hasAttribute("compact", false);
+        std::shared_ptr<ptrn::Pattern> entryTemplate, movedTemplate;
+
         size_t size    = 0;
         u64 entryIndex = 0;
 
@@ -270,7 +416,12 @@ namespace pl::core::ast {
             if (arrayPattern->getEntryCount() > 0)
                 arrayPattern->setTypeName(arrayPattern->getEntry(0)->getTypeName());
 
-            arrayPattern->setEntries(entries);
+            if (lazy)
+                arrayPattern->setLazyEntries(std::move(lazyEntries), std::move(lazyTypeName), this->createEntryMaterializer(evaluator), evaluator->getLazyEntryLimit());
+            else if (compact && !lazyEntries.empty())
+                arrayPattern->setCompactEntries(std::move(lazyEntries), std::move(entryTemplate));
+            else
+                arrayPattern->setEntries(entries);
             arrayPattern->setSize(size);
 
             resultPattern = std::move(arrayPattern);
@@ -287,7 +438,38 @@ namespace pl::core::ast {
                 size += pattern->getSize();
                 entryIndex++;
 
-                entries.push_back(std::move(pattern));
+                if (compact) {
+                    if (entryTemplate == nullptr) {
+                        entryTemplate = pattern;
+                        movedTemplate = pattern->clone();
+                    } else {
+                        movedTemplate->setOffset(pattern->getOffset());
+                        if (!isSameLayout(*movedTemplate, *pattern)) {
+                            // Turn the entries recorded so far back into patterns and store every entry from now on
+                            u64 index = 0;
+                            for (const auto &location : lazyEntries) {
+                                auto entry = entryTemplate->clone();
+                                entry->setOffset(location.offset);
+                                entry->setArrayIndex(index++);
+                                entries.push_back(std::move(entry));
+                            }
+
+                            compact = false;
+                            lazyEntries.clear();
+                            entryTemplate.reset();
+                            movedTemplate.reset();
+                        }
+                    }
+                }
+
+                if (lazy || compact) {
+                    if (lazyTypeName.empty())
+                        lazyTypeName = pattern->getTypeName();
+
+                    lazyEntries.push_back({ pattern->getOffset(), pattern->getSize() });
+                } else {
+                    entries.push_back(std::move(pattern));
+                }
 
                 evaluator->handleAbort();
             }
@@ -295,7 +477,10 @@ namespace pl::core::ast {
 
         auto discardEntries = [&](u32 count) {
             for (u32 i = 0; i < count; i++) {
-                entries.pop_back();
+                if (lazy || compact)
+                    lazyEntries.pop_back();
+                else
+                    entries.pop_back();
                 entryIndex--;
             }
         };
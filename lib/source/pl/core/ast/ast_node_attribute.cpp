@@ -15,7 +15,7 @@
 namespace pl::core::ast {
 
     ASTNodeAttribute::ASTNodeAttribute(std::string attribute, std::vector<std::unique_ptr<ASTNode>> &&value, std::string aliasNamespaceString, std::string autoNamespace)
-        : ASTNode(), m_attribute(std::move(attribute)), m_value(std::move(value)), m_aliasNamespaceString(std::move(aliasNamespaceString)), m_autoNamespace(std::move(autoNamespace)) { }
+        : ASTNode(Kind::Attribute), m_attribute(std::move(attribute)), m_value(std::move(value)), m_aliasNamespaceString(std::move(aliasNamespaceString)), m_autoNamespace(std::move(autoNamespace)) { }
 
     ASTNodeAttribute::ASTNodeAttribute(const ASTNodeAttribute &other) : ASTNode(other) {
         this->m_attribute = other.m_attribute;
@@ -197,7 +197,7 @@ namespace pl::core::ast {
 
                 for (const auto& entry : child->getEntries()) {
                     for (auto &existingPattern : *currScope.scope) {
-                        if (entry->hasVariableName() && existingPattern->getVariableName() == entry->getVariableName()) {
+                        if (entry->hasVariableName() && existingPattern->hasSameVariableName(*entry)) {
                             err::E0008.throwError(fmt::format("Cannot merge '{}' from Type '{}' into current scope. Pattern with this name already exists.", entry->getVariableName(), pattern->getTypeName()), "", node->getLocation());
                         }
                     }
@@ -246,13 +246,13 @@ namespace pl::core::ast {
             if (function->parameterCount != api::FunctionParameterCount::exactly(1))
                 err::E0009.throwError(fmt::format("Formatter function '{}' needs to take exactly one parameter.", functionName), fmt::format("Try 'fn {}({} value)' instead", functionName, pattern->getTypeName()), node->getLocation());
 
-            auto array = dynamic_cast<ptrn::PatternArrayDynamic *>(pattern.get());
+            auto array = ptrn::pattern_cast<ptrn::PatternArrayDynamic>(pattern.get());
             if (array == nullptr)
                 err::E0009.throwError("The [[format_read_entries]] attribute can only be applied to dynamic array types.", {}, node->getLocation());
 
-            for (const auto &entry : array->getEntries()) {
+            array->modifyEntries([functionName](const auto &entry) {
                 entry->setReadFormatterFunction(functionName);
-            }
+            });
         }
 
         if (const auto &arguments = attributable->getAttributeArguments("format_write_entries"); arguments.size() == 1) {
@@ -264,13 +264,13 @@ namespace pl::core::ast {
             if (function->parameterCount != api::FunctionParameterCount::exactly(1))
                 err::E0009.throwError(fmt::format("Formatter function '{}' needs to take exactly one parameter.", functionName), fmt::format("Try 'fn {}({} value)' instead", functionName, pattern->getTypeName()), node->getLocation());
 
-            auto array = dynamic_cast<ptrn::PatternArrayDynamic *>(pattern.get());
+            auto array = ptrn::pattern_cast<ptrn::PatternArrayDynamic>(pattern.get());
             if (array == nullptr)
                 err::E0009.throwError("The [[format_write_entries]] attribute can only be applied to dynamic array types.", {}, node->getLocation());
 
-            for (const auto &entry : array->getEntries()) {
+            array->modifyEntries([functionName](const auto &entry) {
                 entry->setWriteFormatterFunction(functionName);
-            }
+            });
         }
 
         if (const auto &arguments = attributable->getAttributeArguments("transform"); arguments.size() == 1) {
@@ -294,13 +294,13 @@ namespace pl::core::ast {
             if (function->parameterCount != api::FunctionParameterCount::exactly(1))
                 err::E0009.throwError(fmt::format("Transform function '{}' needs to take exactly one parameter.", functionName), fmt::format("Try 'fn {}({} value)' instead", functionName, pattern->getTypeName()), node->getLocation());
 
-            auto array = dynamic_cast<ptrn::PatternArrayDynamic *>(pattern.get());
+            auto array = ptrn::pattern_cast<ptrn::PatternArrayDynamic>(pattern.get());
             if (array == nullptr)
                 err::E0009.throwError("The [[transform_entries]] attribute can only be applied to dynamic array types.", {}, node->getLocation());
 
-            for (const auto &entry : array->getEntries()) {
+            array->modifyEntries([functionName](const auto &entry) {
                 entry->setTransformFunction(functionName);
-            }
+            });
         }
 
         if (const auto &arguments = attributable->getAttributeArguments("pointer_base"); arguments.size() == 1) {
@@ -310,7 +310,7 @@ namespace pl::core::ast {
                 err::E0009.throwError(fmt::format("Pointer base function '{}' does not exist.", functionName), {}, node->getLocation());
 
 
-            if (auto pointerPattern = dynamic_cast<ptrn::PatternPointer *>(pattern.get())) {
+            if (auto pointerPattern = ptrn::pattern_cast<ptrn::PatternPointer>(pattern.get())) {
                 i128 pointerValue = pointerPattern->getPointedAtAddress();
 
                 if (function->parameterCount != api::FunctionParameterCount::exactly(1))
@@ -365,20 +365,36 @@ namespace pl::core::ast {
             }
         }
 
-        for (const auto &attribute : attributable->getAttributes()) {
-            if (const auto &arguments = attribute->getArguments(); !arguments.empty()) {
-                std::vector<core::Token::Literal> evaluatedArguments;
-                for (const auto &argument : arguments) {
-                    auto evaluatedArgument = argument->evaluate(evaluator);
-                    if (auto literalNode = dynamic_cast<ASTNodeLiteral*>(evaluatedArgument.get()); literalNode != nullptr)
-                        evaluatedArguments.push_back(literalNode->getValue());
-                }
+        if (attributable->getAttributes().empty())
+            return;
+
+        // Declarations whose attributes only have literal arguments produce the same attribute set for every pattern, so all of them share it
+        if (const auto constantAttributes = evaluator->getConstantAttributes(node); constantAttributes != nullptr) {
+            pattern->addAttributes(*constantAttributes);
+            return;
+        }
 
-                pattern->addAttribute(attribute->getAttribute(), evaluatedArguments);
+        ptrn::AttributeMap attributes;
+        bool constant = true;
+        for (const auto &attribute : attributable->getAttributes()) {
+            std::vector<core::Token::Literal> evaluatedArguments;
+            for (const auto &argument : attribute->getArguments()) {
+                if (dynamic_cast<const ASTNodeLiteral*>(argument.get()) == nullptr)
+                    constant = false;
+
+                auto evaluatedArgument = argument->evaluate(evaluator);
+                if (auto literalNode = dynamic_cast<ASTNodeLiteral*>(evaluatedArgument.get()); literalNode != nullptr)
+                    evaluatedArguments.push_back(literalNode->getValue());
             }
-            else
-                pattern->addAttribute(attribute->getAttribute());
+
+            attributes[attribute->getAttribute()] = std::move(evaluatedArguments);
         }
+
+        hlp::CopyOnWrite<ptrn::AttributeMap> attributeSet(std::move(attributes));
+        pattern->addAttributes(attributeSet);
+
+        if (constant)
+            evaluator->setConstantAttributes(node, std::move(attributeSet));
     }
 
     void applyVariableAttributes(Evaluator *evaluator, const ASTNode *node, const std::shared_ptr<ptrn::Pattern> &pattern) {
@@ -393,7 +409,7 @@ namespace pl::core::ast {
         evaluator->setReadOffset(pattern->getOffset());
         ON_SCOPE_EXIT {
             if (attributable->hasAttribute("no_unique_address", false)) {
-                if (auto bitfieldPattern = dynamic_cast<const ptrn::PatternBitfieldField*>(pattern.get()); bitfieldPattern != nullptr) {
+                if (auto bitfieldPattern = ptrn::pattern_cast<const ptrn::PatternBitfieldField>(pattern.get()); bitfieldPattern != nullptr) {
                     evaluator->setBitwiseReadOffset(ByteAndBitOffset {
                         .byteOffset = bitfieldPattern->getOffset(),
                         .bitOffset = bitfieldPattern->getBitOffset()
@@ -26,7 +26,7 @@ namespace pl::core::ast {
         [[maybe_unused]] auto context = evaluator->updateRuntime(this);
 
         auto position = evaluator->getBitwiseReadOffset();
-        auto bitfieldPattern = std::make_shared<ptrn::PatternBitfield>(evaluator, position.byteOffset, position.bitOffset, 0, getLocation().line);
+        auto bitfieldPattern = evaluator->createPattern<ptrn::PatternBitfield>(position.byteOffset, position.bitOffset, 0, getLocation().line);
 
         bitfieldPattern->setSection(evaluator->getSectionId());
 
@@ -138,7 +138,7 @@ namespace pl::core::ast {
         }
 
         for (auto &pattern : potentialPatterns) {
-            if (auto bitfieldMember = dynamic_cast<ptrn::PatternBitfieldMember*>(pattern.get()); bitfieldMember != nullptr) {
+            if (auto bitfieldMember = ptrn::pattern_cast<ptrn::PatternBitfieldMember>(pattern.get()); bitfieldMember != nullptr) {
                 bitfieldMember->setParent(bitfieldPattern->reference());
                 if (!bitfieldMember->isPadding())
                     fields.push_back(pattern);
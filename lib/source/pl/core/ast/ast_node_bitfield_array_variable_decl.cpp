@@ -6,7 +6,7 @@
 namespace pl::core::ast {
 
     ASTNodeBitfieldArrayVariableDecl::ASTNodeBitfieldArrayVariableDecl(std::string name, std::shared_ptr<ASTNodeTypeApplication> type, std::unique_ptr<ASTNode> &&size)
-    : ASTNode(), m_name(std::move(name)), m_type(std::move(type)), m_size(std::move(size)) { }
+    : ASTNode(Kind::BitfieldArrayVariableDecl), m_name(std::move(name)), m_type(std::move(type)), m_size(std::move(size)) { }
 
     ASTNodeBitfieldArrayVariableDecl::ASTNodeBitfieldArrayVariableDecl(const ASTNodeBitfieldArrayVariableDecl &other) : ASTNode(other), Attributable(other) {
         this->m_name = other.m_name;
@@ -50,7 +50,7 @@ namespace pl::core::ast {
         };
 
         auto position = evaluator->getBitwiseReadOffset();
-        auto arrayPattern = std::make_shared<ptrn::PatternBitfieldArray>(evaluator, position.byteOffset, position.bitOffset, 0, getLocation().line);
+        auto arrayPattern = evaluator->createPattern<ptrn::PatternBitfieldArray>(position.byteOffset, position.bitOffset, 0, getLocation().line);
         arrayPattern->setVariableName(this->m_name);
         arrayPattern->setSection(evaluator->getSectionId());
         arrayPattern->setReversed(evaluator->isReadOrderReversed());
@@ -129,7 +129,7 @@ namespace pl::core::ast {
             }
 
             for (auto &pattern : entries) {
-                if (auto bitfieldMember = dynamic_cast<ptrn::PatternBitfieldMember*>(pattern.get()); bitfieldMember != nullptr)
+                if (auto bitfieldMember = ptrn::pattern_cast<ptrn::PatternBitfieldMember>(pattern.get()); bitfieldMember != nullptr)
                     bitfieldMember->setParent(arrayPattern->reference());
             }
 
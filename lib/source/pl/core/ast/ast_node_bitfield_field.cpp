@@ -11,7 +11,10 @@
 namespace pl::core::ast {
 
     ASTNodeBitfieldField::ASTNodeBitfieldField(std::string name, std::unique_ptr<ASTNode> &&size)
-    : ASTNode(), m_name(std::move(name)), m_size(std::move(size)) { }
+    : ASTNodeBitfieldField(Kind::BitfieldField, std::move(name), std::move(size)) { }
+
+    ASTNodeBitfieldField::ASTNodeBitfieldField(Kind kind, std::string name, std::unique_ptr<ASTNode> &&size)
+    : ASTNode(kind), m_name(std::move(name)), m_size(std::move(size)) { }
 
     ASTNodeBitfieldField::ASTNodeBitfieldField(const ASTNodeBitfieldField &other) : ASTNode(other), Attributable(other) {
         this->m_name = other.m_name;
@@ -25,7 +28,7 @@ namespace pl::core::ast {
     [[nodiscard]] bool ASTNodeBitfieldField::isPadding() const { return this->getName() == "$padding$"; }
 
     [[nodiscard]] std::shared_ptr<ptrn::PatternBitfieldField> ASTNodeBitfieldField::createBitfield(Evaluator *evaluator, u64 byteOffset, u8 bitOffset, u8 bitSize) const {
-        return std::make_shared<ptrn::PatternBitfieldField>(evaluator, byteOffset, bitOffset, bitSize, getLocation().line);
+        return evaluator->createPattern<ptrn::PatternBitfieldField>(byteOffset, bitOffset, bitSize, getLocation().line);
     }
 
     void ASTNodeBitfieldField::createPatterns(Evaluator *evaluator, std::vector<std::shared_ptr<ptrn::Pattern>> &resultPatterns) const {
@@ -57,12 +60,12 @@ namespace pl::core::ast {
 
 
     [[nodiscard]] std::shared_ptr<ptrn::PatternBitfieldField> ASTNodeBitfieldFieldSigned::createBitfield(Evaluator *evaluator, u64 byteOffset, u8 bitOffset, u8 bitSize) const {
-        return std::make_shared<ptrn::PatternBitfieldFieldSigned>(evaluator, byteOffset, bitOffset, bitSize, getLocation().line);
+        return evaluator->createPattern<ptrn::PatternBitfieldFieldSigned>(byteOffset, bitOffset, bitSize, getLocation().line);
     }
 
 
     ASTNodeBitfieldFieldSizedType::ASTNodeBitfieldFieldSizedType(std::string name, std::unique_ptr<ASTNodeTypeApplication> &&type, std::unique_ptr<ASTNode> &&size)
-    : ASTNodeBitfieldField(std::move(name), std::move(size)), m_type(std::move(type)) { }
+    : ASTNodeBitfieldField(Kind::BitfieldFieldSizedType, std::move(name), std::move(size)), m_type(std::move(type)) { }
 
     ASTNodeBitfieldFieldSizedType::ASTNodeBitfieldFieldSizedType(const ASTNodeBitfieldFieldSizedType &other) : ASTNodeBitfieldField(other) {
         this->m_type = std::unique_ptr<ASTNodeTypeApplication>(static_cast<ASTNodeTypeApplication*>(other.m_type->clone().release()));
@@ -78,13 +81,13 @@ namespace pl::core::ast {
     std::shared_ptr<ptrn::PatternBitfieldField> result = nullptr;
     evaluator->setBitwiseReadOffset(originalPosition);
 
-    if (auto *patternEnum = dynamic_cast<ptrn::PatternEnum *>(pattern.get()); patternEnum != nullptr) {
+    if (auto *patternEnum = ptrn::pattern_cast<ptrn::PatternEnum>(pattern.get()); patternEnum != nullptr) {
         auto bitfieldEnum = std::make_unique<ptrn::PatternBitfieldFieldEnum>(evaluator, byteOffset, bitOffset, bitSize, getLocation().line);
         bitfieldEnum->setTypeName(patternEnum->getTypeName());
         bitfieldEnum->setEnumValues(patternEnum->getEnumValues());
         result = std::move(bitfieldEnum);
-    } else if (dynamic_cast<ptrn::PatternBoolean *>(pattern.get()) != nullptr) {
-        result = std::make_shared<ptrn::PatternBitfieldFieldBoolean>(evaluator, byteOffset, bitOffset, bitSize, getLocation().line);
+    } else if (ptrn::pattern_cast<ptrn::PatternBoolean>(pattern.get()) != nullptr) {
+        result = evaluator->createPattern<ptrn::PatternBitfieldFieldBoolean>(byteOffset, bitOffset, bitSize, getLocation().line);
     } else {
         err::E0004.throwError("Bit size specifiers may only be used with unsigned, signed, bool or enum types.", {}, this->getLocation());
     }
@@ -15,7 +15,7 @@
 namespace pl::core::ast {
 
     ASTNodeBuiltinType::ASTNodeBuiltinType(Token::ValueType type)
-    : ASTNode(), m_type(type) { }
+    : ASTNode(Kind::BuiltinType), m_type(type) { }
 
     void ASTNodeBuiltinType::createPatterns(Evaluator *evaluator, std::vector<std::shared_ptr<ptrn::Pattern>> &resultPatterns) const {
         [[maybe_unused]] auto context = evaluator->updateRuntime(this);
@@ -25,21 +25,21 @@ namespace pl::core::ast {
 
         std::shared_ptr<ptrn::Pattern> pattern;
         if (Token::isUnsigned(this->m_type))
-            pattern = std::make_shared<ptrn::PatternUnsigned>(evaluator, offset, size, getLocation().line);
+            pattern = evaluator->createPattern<ptrn::PatternUnsigned>(offset, size, getLocation().line);
         else if (Token::isSigned(this->m_type))
-            pattern = std::make_shared<ptrn::PatternSigned>(evaluator, offset, size, getLocation().line);
+            pattern = evaluator->createPattern<ptrn::PatternSigned>(offset, size, getLocation().line);
         else if (Token::isFloatingPoint(this->m_type))
-            pattern = std::make_shared<ptrn::PatternFloat>(evaluator, offset, size, getLocation().line);
+            pattern = evaluator->createPattern<ptrn::PatternFloat>(offset, size, getLocation().line);
         else if (this->m_type == Token::ValueType::Boolean)
-            pattern = std::make_shared<ptrn::PatternBoolean>(evaluator, offset, getLocation().line);
+            pattern = evaluator->createPattern<ptrn::PatternBoolean>(offset, getLocation().line);
         else if (this->m_type == Token::ValueType::Character)
-            pattern = std::make_shared<ptrn::PatternCharacter>(evaluator, offset, getLocation().line);
+            pattern = evaluator->createPattern<ptrn::PatternCharacter>(offset, getLocation().line);
         else if (this->m_type == Token::ValueType::Character16)
-            pattern = std::make_shared<ptrn::PatternWideCharacter>(evaluator, offset, getLocation().line);
+            pattern = evaluator->createPattern<ptrn::PatternWideCharacter>(offset, getLocation().line);
         else if (this->m_type == Token::ValueType::Padding)
-            pattern = std::make_shared<ptrn::PatternPadding>(evaluator, offset, 1, getLocation().line);
+            pattern = evaluator->createPattern<ptrn::PatternPadding>(offset, 1, getLocation().line);
         else if (this->m_type == Token::ValueType::String)
-            pattern = std::make_shared<ptrn::PatternString>(evaluator, offset, 0, getLocation().line);
+            pattern = evaluator->createPattern<ptrn::PatternString>(offset, 0, getLocation().line);
         else if (this->m_type == Token::ValueType::CustomType) {
             std::vector<Token::Literal> params;
 
@@ -105,7 +105,7 @@ namespace pl::core::ast {
         literal));
     }
 
-    ASTNodeCast::ASTNodeCast(std::unique_ptr<ASTNode> &&value, std::unique_ptr<ASTNodeTypeApplication> &&type, bool reinterpret) : m_value(std::move(value)), m_type(std::move(type)), m_reinterpret(reinterpret) { }
+    ASTNodeCast::ASTNodeCast(std::unique_ptr<ASTNode> &&value, std::unique_ptr<ASTNodeTypeApplication> &&type, bool reinterpret) : ASTNode(Kind::Cast), m_value(std::move(value)), m_type(std::move(type)), m_reinterpret(reinterpret) { }
 
     ASTNodeCast::ASTNodeCast(const ASTNodeCast &other) : ASTNode(other) {
         this->m_value = other.m_value->clone();
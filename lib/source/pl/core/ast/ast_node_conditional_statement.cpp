@@ -8,7 +8,7 @@
 namespace pl::core::ast {
 
     ASTNodeConditionalStatement::ASTNodeConditionalStatement(std::unique_ptr<ASTNode> condition, std::vector<std::unique_ptr<ASTNode>> &&trueBody, std::vector<std::unique_ptr<ASTNode>> &&falseBody)
-    : ASTNode(), m_condition(std::move(condition)), m_trueBody(std::move(trueBody)), m_falseBody(std::move(falseBody)) { }
+    : ASTNode(Kind::ConditionalStatement), m_condition(std::move(condition)), m_trueBody(std::move(trueBody)), m_falseBody(std::move(falseBody)) { }
 
 
     ASTNodeConditionalStatement::ASTNodeConditionalStatement(const ASTNodeConditionalStatement &other) : ASTNode(other) {
@@ -18,6 +18,8 @@ namespace pl::core::ast {
             this->m_trueBody.push_back(statement->clone());
         for (auto &statement : other.m_falseBody)
             this->m_falseBody.push_back(statement->clone());
+
+        this->m_constantCondition = other.m_constantCondition;
     }
 
     void ASTNodeConditionalStatement::createPatterns(Evaluator *evaluator, std::vector<std::shared_ptr<ptrn::Pattern>> &) const {
@@ -80,6 +82,9 @@ namespace pl::core::ast {
     }
 
     [[nodiscard]] bool ASTNodeConditionalStatement::evaluateCondition(const std::unique_ptr<ASTNode> &condition, Evaluator *evaluator) const {
+        if (this->m_constantCondition.has_value())
+            return *this->m_constantCondition;
+
         const auto node    = condition->evaluate(evaluator);
         const auto literal = dynamic_cast<ASTNodeLiteral *>(node.get());
         if (literal == nullptr)
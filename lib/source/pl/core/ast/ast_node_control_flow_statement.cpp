@@ -8,7 +8,7 @@
 namespace pl::core::ast {
 
     ASTNodeControlFlowStatement::ASTNodeControlFlowStatement(ControlFlowStatement type, std::unique_ptr<ASTNode> &&rvalue)
-        : m_type(type), m_rvalue(std::move(rvalue)) { }
+        : ASTNode(Kind::ControlFlowStatement), m_type(type), m_rvalue(std::move(rvalue)) { }
 
     ASTNodeControlFlowStatement::ASTNodeControlFlowStatement(const ASTNodeControlFlowStatement &other) : ASTNode(other) {
         this->m_type = other.m_type;
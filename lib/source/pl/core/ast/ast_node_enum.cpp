@@ -9,7 +9,7 @@
 
 namespace pl::core::ast {
 
-    ASTNodeEnum::ASTNodeEnum(std::unique_ptr<ASTNode> &&underlyingType) : m_underlyingType(std::move(underlyingType)) { }
+    ASTNodeEnum::ASTNodeEnum(std::unique_ptr<ASTNode> &&underlyingType) : ASTNode(Kind::Enum), m_underlyingType(std::move(underlyingType)) { }
 
     ASTNodeEnum::ASTNodeEnum(const ASTNodeEnum &other) : ASTNode(other), Attributable(other) {
         for (const auto &[name, expr] : other.getEntries()) {
@@ -18,10 +18,14 @@ namespace pl::core::ast {
         }
         this->m_underlyingType = other.m_underlyingType->clone();
 
+        std::scoped_lock lock(other.m_cacheMutex);
         this->m_cachedEnumValues = other.m_cachedEnumValues;
     }
 
     [[nodiscard]] const ptrn::PatternEnum::EnumValue& ASTNodeEnum::getEnumValue(Evaluator *evaluator, const std::string &name) const {
+        // The cache is shared between all runtimes evaluating this AST. Values only ever get added to it so references stay valid
+        std::scoped_lock lock(this->m_cacheMutex);
+
         if (!m_cachedEnumValues.contains(name)) {
             auto it = this->m_entries.find(name);
             if (it == this->m_entries.end())
@@ -52,6 +56,8 @@ namespace pl::core::ast {
     }
 
     [[nodiscard]] const std::map<std::string, ptrn::PatternEnum::EnumValue>& ASTNodeEnum::getEnumValues(Evaluator *evaluator) const {
+        std::scoped_lock lock(this->m_cacheMutex);
+
         if (m_cachedEnumValues.size() != m_entries.size()) {
             for (const auto &[name, values] : m_entries) {
                 (void)getEnumValue(evaluator, name);
@@ -73,7 +79,7 @@ namespace pl::core::ast {
             err::E0005.throwError("'auto' can only be used with parameters.", { }, this->getLocation());
         auto &underlying = underlyingTypePatterns.front();
 
-        auto pattern = std::make_shared<ptrn::PatternEnum>(evaluator, underlying->getOffset(), 0, getLocation().line);
+        auto pattern = evaluator->createPattern<ptrn::PatternEnum>(underlying->getOffset(), 0, getLocation().line);
 
         pattern->setSection(evaluator->getSectionId());
 
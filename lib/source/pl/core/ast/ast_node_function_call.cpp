@@ -10,7 +10,7 @@
 namespace pl::core::ast {
 
     ASTNodeFunctionCall::ASTNodeFunctionCall(std::string functionName, std::vector<std::unique_ptr<ASTNode>> &&params)
-    : ASTNode(), m_functionName(std::move(functionName)), m_params(std::move(params)) { }
+    : ASTNode(Kind::FunctionCall), m_functionName(std::move(functionName)), m_params(std::move(params)) { }
 
     ASTNodeFunctionCall::ASTNodeFunctionCall(const ASTNodeFunctionCall &other) : ASTNode(other) {
         this->m_functionName = other.m_functionName;
@@ -48,9 +48,9 @@ namespace pl::core::ast {
         }
 
         const auto &functionName = this->getFunctionName();
-        auto function = evaluator->findFunction(functionName);
+        auto function = evaluator->getCallTarget(this->getCallSiteId(), functionName);
 
-        if (!function.has_value()) {
+        if (function == nullptr) {
             if (functionName.starts_with("std::")) {
                 evaluator->getConsole().log(LogConsole::Level::Warning, "This function might be part of the standard library.\nYou can install the standard library though\nthe Content Store found under Extras -> Content Store and then\ninclude the correct file.");
             }
@@ -4,7 +4,7 @@
 
 namespace pl::core::ast {
 
-    ASTNodeImportedType::ASTNodeImportedType(const std::string &importedTypeName) : m_importedTypeName(importedTypeName) {
+    ASTNodeImportedType::ASTNodeImportedType(const std::string &importedTypeName) : ASTNode(Kind::ImportedType), m_importedTypeName(importedTypeName) {
 
     }
 
@@ -33,7 +33,7 @@ namespace pl::core::ast {
 
             result = std::move(pattern);
         } else {
-            auto structPattern = std::make_shared<ptrn::PatternStruct>(evaluator, 0x00, 0, getLocation().line);
+            auto structPattern = evaluator->createPattern<ptrn::PatternStruct>(0x00, 0, getLocation().line);
 
             u64 minPos = std::numeric_limits<u64>::max();
             u64 maxPos = std::numeric_limits<u64>::min();
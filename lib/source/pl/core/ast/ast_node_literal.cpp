@@ -5,6 +5,6 @@
 
 namespace pl::core::ast {
 
-    ASTNodeLiteral::ASTNodeLiteral(Token::Literal literal) : ASTNode(), m_literal(std::move(literal)) { }
+    ASTNodeLiteral::ASTNodeLiteral(Token::Literal literal) : ASTNode(Kind::Literal), m_literal(std::move(literal)) { }
 
 }
\ No newline at end of file
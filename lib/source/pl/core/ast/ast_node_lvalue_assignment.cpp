@@ -7,7 +7,7 @@
 
 namespace pl::core::ast {
 
-    ASTNodeLValueAssignment::ASTNodeLValueAssignment(std::string lvalueName, std::unique_ptr<ASTNode> &&rvalue) : m_lvalueName(std::move(lvalueName)), m_rvalue(std::move(rvalue)) {
+    ASTNodeLValueAssignment::ASTNodeLValueAssignment(std::string lvalueName, std::unique_ptr<ASTNode> &&rvalue) : ASTNode(Kind::LValueAssignment), m_lvalueName(std::move(lvalueName)), m_rvalue(std::move(rvalue)) {
     }
 
     ASTNodeLValueAssignment::ASTNodeLValueAssignment(const ASTNodeLValueAssignment &other) : ASTNode(other), Attributable(other) {
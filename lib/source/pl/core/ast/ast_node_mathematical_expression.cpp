@@ -47,20 +47,28 @@ namespace pl::core::ast {
 
 
     ASTNodeMathematicalExpression::ASTNodeMathematicalExpression(std::unique_ptr<ASTNode> &&left, std::unique_ptr<ASTNode> &&right, Token::Operator op)
-    : m_left(std::move(left)), m_right(std::move(right)), m_operator(op) { }
+    : ASTNode(Kind::MathematicalExpression), m_left(std::move(left)), m_right(std::move(right)), m_operator(op) { }
 
     ASTNodeMathematicalExpression::ASTNodeMathematicalExpression(const ASTNodeMathematicalExpression &other) : ASTNode(other) {
         this->m_operator = other.m_operator;
         this->m_left     = other.m_left == nullptr ? nullptr : other.m_left->clone();
         this->m_right    = other.m_right == nullptr ? nullptr : other.m_right->clone();
+        this->m_constantValue = other.m_constantValue;
     }
 
     [[nodiscard]] std::unique_ptr<ASTNode> ASTNodeMathematicalExpression::evaluate(Evaluator *evaluator) const {
+        if (this->m_constantValue.has_value())
+            return std::unique_ptr<ASTNode>(new ASTNodeLiteral(*this->m_constantValue));
+
         [[maybe_unused]] auto context = evaluator->updateRuntime(this);
 
         if (this->getLeftOperand() == nullptr || this->getRightOperand() == nullptr)
             err::E0002.throwError("Cannot evaluate void expression", "Did you try to work with the result of a function that didn't return anything?", this->getLocation());
 
+        // Integral expressions get evaluated by the bytecode machine without allocating a node for every intermediate result
+        if (auto result = this->m_compiled.execute(evaluator, this); result.has_value())
+            return std::unique_ptr<ASTNode>(new ASTNodeLiteral(std::move(*result)));
+
         const auto throwInvalidOperandError = [this]() -> ASTNode * {
             err::E0002.throwError("Invalid operand used in mathematical expression.", { }, this->getLocation());
             return nullptr;
@@ -7,7 +7,7 @@
 
 namespace pl::core::ast {
 
-    ASTNodeMultiVariableDecl::ASTNodeMultiVariableDecl(std::vector<std::shared_ptr<ASTNode>> &&variables) : m_variables(std::move(variables)) { }
+    ASTNodeMultiVariableDecl::ASTNodeMultiVariableDecl(std::vector<std::shared_ptr<ASTNode>> &&variables) : ASTNode(Kind::MultiVariableDecl), m_variables(std::move(variables)) { }
 
     ASTNodeMultiVariableDecl::ASTNodeMultiVariableDecl(const ASTNodeMultiVariableDecl &other) : ASTNode(other) {
         for (auto &variable : other.m_variables)
@@ -5,6 +5,6 @@
 
 namespace pl::core::ast {
 
-    ASTNodeParameterPack::ASTNodeParameterPack(std::vector<Token::Literal> &&values) : m_values(std::move(values)) { }
+    ASTNodeParameterPack::ASTNodeParameterPack(std::vector<Token::Literal> &&values) : ASTNode(Kind::ParameterPack), m_values(std::move(values)) { }
 
 }
\ No newline at end of file
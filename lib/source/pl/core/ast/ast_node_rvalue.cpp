@@ -24,7 +24,7 @@
 
 namespace pl::core::ast {
 
-    ASTNodeRValue::ASTNodeRValue(Path &&path) : m_path(std::move(path)) { }
+    ASTNodeRValue::ASTNodeRValue(Path &&path) : ASTNode(Kind::RValue), m_path(std::move(path)) { }
 
     ASTNodeRValue::ASTNodeRValue(const ASTNodeRValue &other) : ASTNode(other) {
         for (auto &part : other.m_path) {
@@ -49,6 +49,126 @@ namespace pl::core::ast {
             value = hlp::changeEndianess(value, variablePattern->getSize(), variablePattern->getEndian());
     }
 
+    // Reads the value of a pattern of a builtin scalar type. Returns nothing for all other patterns
+    static std::optional<Token::Literal> readScalarValue(Evaluator *evaluator, ptrn::Pattern *pattern) {
+        switch (pattern->getPatternKind()) {
+            case ptrn::PatternKind::Unsigned: {
+                u128 value = 0;
+                readVariable(evaluator, value, pattern);
+                return value;
+            }
+            case ptrn::PatternKind::Signed: {
+                i128 value = 0;
+                readVariable(evaluator, value, pattern);
+                return hlp::signExtend(pattern->getSize() * 8, value);
+            }
+            case ptrn::PatternKind::Float: {
+                if (pattern->getSize() == sizeof(u16)) {
+                    u16 value = 0;
+                    readVariable(evaluator, value, pattern);
+                    return double(hlp::float16ToFloat32(value));
+                } else if (pattern->getSize() == sizeof(float)) {
+                    float value = 0;
+                    readVariable(evaluator, value, pattern);
+                    return double(value);
+                } else if (pattern->getSize() == sizeof(double)) {
+                    double value = 0;
+                    readVariable(evaluator, value, pattern);
+                    return value;
+                } else
+                    err::E0001.throwError("Invalid floating point type.");
+            }
+            case ptrn::PatternKind::Character: {
+                char value = 0;
+                readVariable(evaluator, value, pattern);
+                return value;
+            }
+            case ptrn::PatternKind::Boolean: {
+                bool value = false;
+                readVariable(evaluator, value, pattern);
+                return value;
+            }
+            case ptrn::PatternKind::BitfieldFieldBoolean:
+                return bool(static_cast<ptrn::PatternBitfieldFieldBoolean *>(pattern)->readValue());
+            case ptrn::PatternKind::BitfieldFieldSigned: {
+                auto bitfieldFieldPatternSigned = static_cast<ptrn::PatternBitfieldFieldSigned *>(pattern);
+                return hlp::signExtend(bitfieldFieldPatternSigned->getBitSize(), i128(bitfieldFieldPatternSigned->readValue()));
+            }
+            case ptrn::PatternKind::BitfieldField:
+                return static_cast<ptrn::PatternBitfieldField *>(pattern)->readValue();
+            default:
+                return std::nullopt;
+        }
+    }
+
+    // Looks up a member of a struct, union or bitfield by the id of its name without copying the list of members
+    static ptrn::Pattern* findMember(Evaluator *evaluator, ptrn::Pattern *pattern, hlp::StringInterner::Id nameId) {
+        ptrn::IIterable *iterable = nullptr;
+        switch (pattern->getPatternKind()) {
+            case ptrn::PatternKind::Struct:
+                iterable = static_cast<ptrn::PatternStruct *>(pattern);
+                break;
+            case ptrn::PatternKind::Union:
+                iterable = static_cast<ptrn::PatternUnion *>(pattern);
+                break;
+            case ptrn::PatternKind::Bitfield:
+                iterable = static_cast<ptrn::PatternBitfield *>(pattern);
+                break;
+            default:
+                return nullptr;
+        }
+
+        // Later members shadow earlier ones with the same name
+        for (size_t i = iterable->getEntryCount(); i > 0; i -= 1) {
+            if (auto entry = iterable->getEntry(i - 1); entry != nullptr && evaluator->getVariableNameId(*entry) == nameId)
+                return entry.get();
+        }
+
+        return nullptr;
+    }
+
+    // Resolves paths like `value` or `header.flags` that only consist of variable and member names to the existing
+    // pattern without going through createPatterns(). Returns nullptr for everything else so the general path can
+    // handle it and report errors
+    static ptrn::Pattern* findScalarVariable(Evaluator *evaluator, const ASTNodeRValue::Path &path) {
+        const auto &parent = evaluator->getScope(0).parent;
+
+        ptrn::Pattern *pattern = nullptr;
+        for (const auto &part : path) {
+            auto name = std::get_if<std::string>(&part);
+            if (name == nullptr || *name == "parent" || *name == "this" || *name == "$" || *name == "null")
+                return nullptr;
+
+            if (pattern == nullptr) {
+                auto variable = evaluator->findVariable(*name);
+                if (variable == nullptr || *variable == nullptr)
+                    return nullptr;
+
+                pattern = variable->get();
+            } else {
+                // Members of the type that's currently being created are looked up through its scope
+                if (pattern == parent.get())
+                    return nullptr;
+
+                auto nameId = evaluator->getStringInterner().find(*name);
+                if (nameId == hlp::StringInterner::None)
+                    return nullptr;
+
+                pattern = findMember(evaluator, pattern, nameId);
+                if (pattern == nullptr)
+                    return nullptr;
+            }
+
+            if (pattern->getPatternKind() == ptrn::PatternKind::Pointer)
+                return nullptr;
+        }
+
+        if (pattern == nullptr || !pattern->getTransformFunction().empty())
+            return nullptr;
+
+        return pattern;
+    }
+
     [[nodiscard]] std::unique_ptr<ASTNode> ASTNodeRValue::evaluate(Evaluator *evaluator) const {
         [[maybe_unused]] auto context = evaluator->updateRuntime(this);
 
@@ -56,7 +176,7 @@ namespace pl::core::ast {
             if (auto name = std::get_if<std::string>(&this->getPath().front()); name != nullptr) {
                 if (*name == "$") return std::make_unique<ASTNodeLiteral>(u128(evaluator->getReadOffset()));
                 else if (*name == "null") return std::make_unique<ASTNodeLiteral>(
-                    std::make_shared<ptrn::PatternPadding>(evaluator, 0, 0, getLocation().line));
+                    evaluator->createPattern<ptrn::PatternPadding>(0, 0, getLocation().line));
 
                 auto parameterPack = evaluator->getScope(0).parameterPack;
                 if (parameterPack && *name == parameterPack->name)
@@ -80,6 +200,12 @@ namespace pl::core::ast {
             }
         }
 
+        // Builtin scalar values are read directly from the variable that's already there
+        if (auto variable = findScalarVariable(evaluator, this->getPath()); variable != nullptr) {
+            if (auto value = readScalarValue(evaluator, variable); value.has_value())
+                return std::make_unique<ASTNodeLiteral>(std::move(*value));
+        }
+
         std::shared_ptr<ptrn::Pattern> pattern;
         {
             std::vector<std::shared_ptr<ptrn::Pattern>> referencedPatterns;
@@ -89,55 +215,17 @@ namespace pl::core::ast {
         }
 
         Token::Literal literal;
-        if (dynamic_cast<ptrn::PatternUnsigned *>(pattern.get()) != nullptr) {
-            u128 value = 0;
-            readVariable(evaluator, value, pattern.get());
-            literal = value;
-        } else if (dynamic_cast<ptrn::PatternSigned *>(pattern.get()) != nullptr) {
-            i128 value = 0;
-            readVariable(evaluator, value, pattern.get());
-            value   = hlp::signExtend(pattern->getSize() * 8, value);
-            literal = value;
-        } else if (dynamic_cast<ptrn::PatternFloat *>(pattern.get()) != nullptr) {
-            if (pattern->getSize() == sizeof(u16)) {
-                u16 value = 0;
-                readVariable(evaluator, value, pattern.get());
-                literal = double(hlp::float16ToFloat32(value));
-            } else if (pattern->getSize() == sizeof(float)) {
-                float value = 0;
-                readVariable(evaluator, value, pattern.get());
-                literal = double(value);
-            } else if (pattern->getSize() == sizeof(double)) {
-                double value = 0;
-                readVariable(evaluator, value, pattern.get());
-                literal = value;
-            } else
-                err::E0001.throwError("Invalid floating point type.");
-        } else if (dynamic_cast<ptrn::PatternCharacter *>(pattern.get()) != nullptr) {
-            char value = 0;
-            readVariable(evaluator, value, pattern.get());
-            literal = value;
-        } else if (dynamic_cast<ptrn::PatternBoolean *>(pattern.get()) != nullptr) {
-            bool value = false;
-            readVariable(evaluator, value, pattern.get());
-            literal = value;
-        } else if (dynamic_cast<ptrn::PatternString *>(pattern.get()) != nullptr) {
+        if (auto value = readScalarValue(evaluator, pattern.get()); value.has_value()) {
+            literal = std::move(*value);
+        } else if (pattern->getPatternKind() == ptrn::PatternKind::String) {
             std::string value;
             readVariable(evaluator, value, pattern.get());
             literal = value;
-        } else if (auto bitfieldFieldPatternBoolean = dynamic_cast<ptrn::PatternBitfieldFieldBoolean *>(pattern.get()); bitfieldFieldPatternBoolean != nullptr) {
-            literal = bool(bitfieldFieldPatternBoolean->readValue());
-        } else if (auto bitfieldFieldPatternSigned = dynamic_cast<ptrn::PatternBitfieldFieldSigned *>(pattern.get()); bitfieldFieldPatternSigned != nullptr) {
-            literal = hlp::signExtend(bitfieldFieldPatternSigned->getBitSize(), i128(bitfieldFieldPatternSigned->readValue()));
-        } else if (auto bitfieldFieldPatternEnum = dynamic_cast<ptrn::PatternBitfieldFieldEnum *>(pattern.get()); bitfieldFieldPatternEnum != nullptr) {
-            literal = pattern;
-        } else if (auto bitfieldFieldPattern = dynamic_cast<ptrn::PatternBitfieldField *>(pattern.get()); bitfieldFieldPattern != nullptr) {
-            literal = bitfieldFieldPattern->readValue();
         } else {
             literal = pattern;
         }
 
-        if (auto transformFunc = evaluator->findFunction(pattern->getTransformFunction()); transformFunc.has_value()) {
+        if (auto transformFunc = evaluator->getFunction(pattern->getTransformFunction()); transformFunc != nullptr) {
             auto oldPatternName = pattern->getVariableName();
             auto result = transformFunc->func(evaluator, { std::move(literal) });
             pattern->setVariableName(oldPatternName);
@@ -196,28 +284,24 @@ namespace pl::core::ast {
                     using std::ranges::find;
                     std::shared_ptr<ptrn::Pattern> pattern;
 
+                    // Members are compared by the id of their name instead of building and comparing their names
+                    const auto getNameId = [evaluator](const std::shared_ptr<ptrn::Pattern> &member) { return evaluator->getVariableNameId(*member); };
+
                     if (currPattern == nullptr) {
-                        auto currScope = *evaluator->getScope(0).scope | all;
-                        auto templateParameters = evaluator->getTemplateParameters() | all;
-                        auto globalScope = *evaluator->getGlobalScope().scope | all;
-                        auto allScopes = {globalScope, templateParameters, currScope};
-                        auto searchScopes = allScopes | drop(evaluator->isGlobalScope() ? 1 : 0);
-                        auto view = searchScopes | join | reverse;
-                        if (auto result = find(view, name, &ptrn::Pattern::getVariableName); result != view.end())
-                            pattern = *result;
+                        if (auto variable = evaluator->findVariable(name); variable != nullptr)
+                            pattern = *variable;
                     } else if (auto currParent = evaluator->getScope(scopeIndex).parent; currParent == currPattern) {
-                        auto view = *evaluator->getScope(scopeIndex).scope | reverse;
-                        if (auto result = find(view, name, &ptrn::Pattern::getVariableName); result != view.end())
-                            pattern = *result;
+                        if (auto variable = evaluator->findVariable(evaluator->getScope(scopeIndex), name); variable != nullptr)
+                            pattern = *variable;
                     } else if (auto indexablePattern = dynamic_cast<ptrn::IIndexable *>(currPattern.get()); indexablePattern != nullptr) {
                         auto iota_view = iota((size_t)0, indexablePattern->getEntryCount());
                         auto view = iota_view | transform(std::bind_front(&ptrn::IIndexable::getEntry, indexablePattern)) | reverse;
-                        if (auto result = find(view, name, &ptrn::Pattern::getVariableName); result != view.end())
+                        if (auto result = find(view, evaluator->getStringInterner().intern(name), getNameId); result != view.end())
                             pattern = *result;
                     } else if (auto iterablePattern = dynamic_cast<ptrn::IIterable *>(currPattern.get()); iterablePattern != nullptr) {
                         auto scope = iterablePattern->getEntries();
                         auto view =  scope | reverse;
-                        if (auto result = find(view, name, &ptrn::Pattern::getVariableName); result != view.end())
+                        if (auto result = find(view, evaluator->getStringInterner().intern(name), getNameId); result != view.end())
                             pattern = *result;
                     }
 
@@ -260,7 +344,7 @@ namespace pl::core::ast {
                 break;
 
 
-            if (auto pointerPattern = dynamic_cast<ptrn::PatternPointer *>(currPattern.get()))
+            if (auto pointerPattern = ptrn::pattern_cast<ptrn::PatternPointer>(currPattern.get()))
                 currPattern = pointerPattern->getPointedAtPattern();
 
             auto indexPattern = currPattern.get();
@@ -8,7 +8,7 @@
 namespace pl::core::ast {
 
     ASTNodeRValueAssignment::ASTNodeRValueAssignment(std::unique_ptr<ASTNode> &&lvalue, std::unique_ptr<ASTNode> &&rvalue)
-        : m_lvalue(std::move(lvalue)), m_rvalue(std::move(rvalue)) { }
+        : ASTNode(Kind::RValueAssignment), m_lvalue(std::move(lvalue)), m_rvalue(std::move(rvalue)) { }
 
     ASTNodeRValueAssignment::ASTNodeRValueAssignment(const ASTNodeRValueAssignment &other) : ASTNode(other) {
         this->m_lvalue = other.m_lvalue->clone();
@@ -9,7 +9,7 @@
 namespace pl::core::ast {
 
     ASTNodeScopeResolution::ASTNodeScopeResolution(std::shared_ptr<ASTNodeTypeDecl> &&type, std::string name)
-        : m_type(std::move(type)), m_name(std::move(name)) { }
+        : ASTNode(Kind::ScopeResolution), m_type(std::move(type)), m_name(std::move(name)) { }
 
     ASTNodeScopeResolution::ASTNodeScopeResolution(const ASTNodeScopeResolution &other) : ASTNode(other) {
         this->m_type = other.m_type;
@@ -18,7 +18,7 @@ namespace pl::core::ast {
         [[maybe_unused]] auto context = evaluator->updateRuntime(this);
 
         evaluator->alignToByte();
-        auto pattern = std::make_shared<ptrn::PatternStruct>(evaluator, evaluator->getReadOffset(), 0, getLocation().line);
+        auto pattern = evaluator->createPattern<ptrn::PatternStruct>(evaluator->getReadOffset(), 0, getLocation().line);
 
         auto startOffset = evaluator->getReadOffset();
         std::vector<std::shared_ptr<ptrn::Pattern>> memberPatterns;
@@ -53,7 +53,7 @@ namespace pl::core::ast {
             inheritance->createPatterns(evaluator, inheritancePatterns);
             auto &inheritancePattern = inheritancePatterns.front();
 
-            if (auto structPattern = dynamic_cast<ptrn::PatternStruct *>(inheritancePattern.get())) {
+            if (auto structPattern = ptrn::pattern_cast<ptrn::PatternStruct>(inheritancePattern.get())) {
                 for (auto &member : structPattern->getEntries()) {
                     memberPatterns.push_back(member);
                 }
@@ -77,7 +77,7 @@ namespace pl::core::ast {
                     continue;
 
                 for (auto &existingPattern : memberPatterns) {
-                    if (existingPattern->getVariableName() == varName) {
+                    if (existingPattern->hasSameVariableName(*memberPattern)) {
                         err::E0003.throwError(fmt::format("Redeclaration of identifier '{}'.", existingPattern->getVariableName()), "", member->getLocation());
                     }
                 }
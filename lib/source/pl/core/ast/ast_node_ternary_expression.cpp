@@ -8,21 +8,28 @@
 namespace pl::core::ast {
 
     ASTNodeTernaryExpression::ASTNodeTernaryExpression(std::unique_ptr<ASTNode> &&first, std::unique_ptr<ASTNode> &&second, std::unique_ptr<ASTNode> &&third, Token::Operator op)
-    : ASTNode(), m_first(std::move(first)), m_second(std::move(second)), m_third(std::move(third)), m_operator(op) { }
+    : ASTNode(Kind::TernaryExpression), m_first(std::move(first)), m_second(std::move(second)), m_third(std::move(third)), m_operator(op) { }
 
     ASTNodeTernaryExpression::ASTNodeTernaryExpression(const ASTNodeTernaryExpression &other) : ASTNode(other) {
         this->m_operator = other.m_operator;
         this->m_first    = other.m_first->clone();
         this->m_second   = other.m_second->clone();
         this->m_third    = other.m_third->clone();
+        this->m_constantValue = other.m_constantValue;
     }
 
     [[nodiscard]] std::unique_ptr<ASTNode> ASTNodeTernaryExpression::evaluate(Evaluator *evaluator) const {
+        if (this->m_constantValue.has_value())
+            return std::unique_ptr<ASTNode>(new ASTNodeLiteral(*this->m_constantValue));
+
         [[maybe_unused]] auto context = evaluator->updateRuntime(this);
 
         if (this->getFirstOperand() == nullptr || this->getSecondOperand() == nullptr || this->getThirdOperand() == nullptr)
             err::E0002.throwError("Void expression used in ternary expression.", "If you used a function for one of the operands, make sure it returned a value.", this->getLocation());
 
+        if (auto result = this->m_compiled.execute(evaluator, this); result.has_value())
+            return std::unique_ptr<ASTNode>(new ASTNodeLiteral(std::move(*result)));
+
         auto conditionNode  = this->getFirstOperand()->evaluate(evaluator);
 
         auto *conditionValue  = dynamic_cast<ASTNodeLiteral *>(conditionNode.get());
@@ -6,7 +6,7 @@
 namespace pl::core::ast {
 
     ASTNodeTryCatchStatement::ASTNodeTryCatchStatement(std::vector<std::unique_ptr<ASTNode>> &&tryBody, std::vector<std::unique_ptr<ASTNode>> &&catchBody)
-        : m_tryBody(std::move(tryBody)), m_catchBody(std::move(catchBody)) { }
+        : ASTNode(Kind::TryCatchStatement), m_tryBody(std::move(tryBody)), m_catchBody(std::move(catchBody)) { }
 
 
     ASTNodeTryCatchStatement::ASTNodeTryCatchStatement(const ASTNodeTryCatchStatement &other) : ASTNode(other) {
@@ -43,6 +43,7 @@ namespace pl::core::ast {
 
             scope.scope->resize(startScopeSize);
             scope.heapStartSize = startHeapSize;
+            evaluator->invalidateVariableLookups();
 
             for (auto &node : this->m_catchBody) {
                 std::vector<std::shared_ptr<ptrn::Pattern>> newPatterns;
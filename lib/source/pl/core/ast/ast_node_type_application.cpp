@@ -34,7 +34,7 @@ namespace pl::core::ast {
     }
     
     ASTNodeTypeApplication::ASTNodeTypeApplication(std::shared_ptr<ASTNode> type)
-        : m_type(std::move(type)) { };
+        : ASTNode(Kind::TypeApplication), m_type(std::move(type)) { };
 
     ASTNodeTypeApplication::ASTNodeTypeApplication(const ASTNodeTypeApplication &other)
         : ASTNode(other), m_type(other.m_type) {
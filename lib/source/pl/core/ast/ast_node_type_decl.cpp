@@ -10,21 +10,27 @@
 
 namespace pl::core::ast {
 
-    ASTNodeTypeDecl::ASTNodeTypeDecl(std::string name) : m_forwardDeclared(true), m_name(std::move(name)) { }
+    ASTNodeTypeDecl::ASTNodeTypeDecl(std::string name) : ASTNode(Kind::TypeDecl), m_forwardDeclared(true), m_name(std::move(name)) { }
 
     ASTNodeTypeDecl::ASTNodeTypeDecl(std::string name, std::shared_ptr<ASTNode> type)
-    : m_name(std::move(name)), m_type(std::move(type)){ }
+    : ASTNode(Kind::TypeDecl), m_name(std::move(name)), m_type(std::move(type)){ }
+
+    // Type declarations that are currently being copied on this thread. Used to stop copying recursive types forever.
+    // This is kept per thread so the same AST can be evaluated by multiple runtimes at once
+    static thread_local std::vector<const ASTNodeTypeDecl*> s_typesBeingCopied;
 
     ASTNodeTypeDecl::ASTNodeTypeDecl(const ASTNodeTypeDecl &other) : ASTNode(other), Attributable(other) {
         this->m_name                = other.m_name;
 
         if (other.m_type != nullptr) {
-            if (auto typeDecl = dynamic_cast<ASTNodeTypeDecl*>(other.m_type.get()); (typeDecl != nullptr && typeDecl->isForwardDeclared() && !typeDecl->isTemplateType()) || other.m_completed || other.m_alreadyCopied)
+            const bool alreadyCopied = std::ranges::find(s_typesBeingCopied, &other) != s_typesBeingCopied.end();
+            if (auto typeDecl = dynamic_cast<ASTNodeTypeDecl*>(other.m_type.get()); (typeDecl != nullptr && typeDecl->isForwardDeclared() && !typeDecl->isTemplateType()) || other.m_completed || alreadyCopied)
                 this->m_type = other.m_type;
             else {
-                other.m_alreadyCopied = true;
+                s_typesBeingCopied.push_back(&other);
+                ON_SCOPE_EXIT { s_typesBeingCopied.pop_back(); };
+
                 this->m_type = other.m_type->clone();
-                other.m_alreadyCopied = false;
             }
         }
 
@@ -49,6 +55,17 @@ namespace pl::core::ast {
     void ASTNodeTypeDecl::createPatterns(Evaluator *evaluator, std::vector<std::shared_ptr<ptrn::Pattern>> &resultPatterns) const {
         [[maybe_unused]] auto context = evaluator->updateRuntime(this);
 
+        // Types with a static layout only get evaluated once, every further instance is a copy of the first one
+        const bool useLayoutTemplate = this->m_staticLayout.has_value() && evaluator->canUseLayoutTemplates();
+        if (useLayoutTemplate) {
+            if (auto pattern = evaluator->instantiateLayoutTemplate(this); pattern != nullptr) {
+                evaluator->setReadOffset(evaluator->getReadOffset() + this->m_staticLayout->size);
+                resultPatterns = hlp::moveToVector<std::shared_ptr<ptrn::Pattern>>(std::move(pattern));
+                return;
+            }
+        }
+
+        const auto paletteIndex = evaluator->getPatternColorPaletteIndex();
         std::vector<std::shared_ptr<ptrn::Pattern>> dummyPatterns;
 
         bool requiresNewScope = dynamic_cast<ASTNodeTypeApplication*>(this->getType().get()) != nullptr;
@@ -71,6 +88,7 @@ namespace pl::core::ast {
         auto& templateArguments = evaluator->getCurrentTemplateArguments();
 
         std::vector<std::shared_ptr<ptrn::Pattern>> templatePatterns;
+        std::unique_ptr<ASTNodeTypeApplication> templateParameterType;
 
         {
             evaluator->pushSectionId(ptrn::Pattern::PatternLocalSectionId);
@@ -89,13 +107,13 @@ namespace pl::core::ast {
                     auto literal = dynamic_cast<ASTNodeLiteral*>(argument.get());
                     auto value = literal->getValue();
                     // Allow the evaluator to throw an error at the correct source location.
-                    if (this->m_currTemplateParameterType == nullptr) {
-                        this->m_currTemplateParameterType = std::make_unique<ASTNodeTypeApplication>(std::make_shared<ASTNodeBuiltinType>(Token::ValueType::Auto));
+                    if (templateParameterType == nullptr) {
+                        templateParameterType = std::make_unique<ASTNodeTypeApplication>(std::make_shared<ASTNodeBuiltinType>(Token::ValueType::Auto));
                     }
 
-                    this->m_currTemplateParameterType->setLocation(templateParameter->getLocation());
+                    templateParameterType->setLocation(templateParameter->getLocation());
 
-                    auto variable = evaluator->createVariable(templateParameter->getName().get(), this->m_currTemplateParameterType.get(), value, false, value.isPattern(), true, true);
+                    auto variable = evaluator->createVariable(templateParameter->getName().get(), templateParameterType.get(), value, false, value.isPattern(), true, true);
                     if (variable != nullptr) {
                         variable->setInitialized(false);
                         evaluator->setVariable(variable, value);
@@ -134,6 +152,9 @@ namespace pl::core::ast {
             }
 
         }
+
+        if (useLayoutTemplate && resultPatterns.size() == 1 && resultPatterns.front() != nullptr && resultPatterns.front()->getSize() == this->m_staticLayout->size)
+            evaluator->setLayoutTemplate(this, resultPatterns.front(), paletteIndex);
     }
 
     void ASTNodeTypeDecl::addAttribute(std::unique_ptr<ASTNodeAttribute> &&attribute) {
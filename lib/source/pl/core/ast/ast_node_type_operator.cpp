@@ -8,18 +8,22 @@
 
 namespace pl::core::ast {
 
-    ASTNodeTypeOperator::ASTNodeTypeOperator(Token::Operator op, std::unique_ptr<ASTNode> &&expression) : m_op(op), m_expression(std::move(expression)) { }
-    ASTNodeTypeOperator::ASTNodeTypeOperator(Token::Operator op) : m_op(op), m_providerOperation(true) { }
+    ASTNodeTypeOperator::ASTNodeTypeOperator(Token::Operator op, std::unique_ptr<ASTNode> &&expression) : ASTNode(Kind::TypeOperator), m_op(op), m_expression(std::move(expression)) { }
+    ASTNodeTypeOperator::ASTNodeTypeOperator(Token::Operator op) : ASTNode(Kind::TypeOperator), m_op(op), m_providerOperation(true) { }
 
     ASTNodeTypeOperator::ASTNodeTypeOperator(const ASTNodeTypeOperator &other) : ASTNode(other) {
         this->m_op = other.m_op;
         this->m_providerOperation = other.m_providerOperation;
+        this->m_constantValue = other.m_constantValue;
 
         if (other.m_expression != nullptr)
             this->m_expression = other.m_expression->clone();
     }
 
     [[nodiscard]] std::unique_ptr<ASTNode> ASTNodeTypeOperator::evaluate(Evaluator *evaluator) const {
+        if (this->m_constantValue.has_value())
+            return std::unique_ptr<ASTNode>(new ASTNodeLiteral(*this->m_constantValue));
+
         [[maybe_unused]] auto context = evaluator->updateRuntime(this);
 
         Token::Literal result;
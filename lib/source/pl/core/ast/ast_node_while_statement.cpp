@@ -6,7 +6,7 @@
 namespace pl::core::ast {
 
     ASTNodeWhileStatement::ASTNodeWhileStatement(std::unique_ptr<ASTNode> &&condition, std::vector<std::unique_ptr<ASTNode>> &&body, std::unique_ptr<ASTNode> &&postExpression)
-    : ASTNode(), m_condition(std::move(condition)), m_body(std::move(body)), m_postExpression(std::move(postExpression)) { }
+    : ASTNode(Kind::WhileStatement), m_condition(std::move(condition)), m_body(std::move(body)), m_postExpression(std::move(postExpression)) { }
 
     ASTNodeWhileStatement::ASTNodeWhileStatement(const ASTNodeWhileStatement &other) : ASTNode(other) {
         this->m_condition = other.m_condition->clone();
@@ -0,0 +1,519 @@
+#include <pl/core/bytecode.hpp>
+
+#include <pl/core/evaluator.hpp>
+#include <pl/helpers/utils.hpp>
+
+#include <wolv/utils/core.hpp>
+
+#include <pl/core/ast/ast_node_literal.hpp>
+#include <pl/core/ast/ast_node_mathematical_expression.hpp>
+#include <pl/core/ast/ast_node_rvalue.hpp>
+#include <pl/core/ast/ast_node_ternary_expression.hpp>
+#include <pl/core/ast/ast_node_type_operator.hpp>
+
+#include <pl/patterns/pattern_boolean.hpp>
+#include <pl/patterns/pattern_character.hpp>
+#include <pl/patterns/pattern_float.hpp>
+#include <pl/patterns/pattern_pointer.hpp>
+#include <pl/patterns/pattern_signed.hpp>
+#include <pl/patterns/pattern_unsigned.hpp>
+
+#include <algorithm>
+#include <array>
+#include <mutex>
+#include <utility>
+
+namespace pl::core::bytecode {
+
+    namespace {
+
+        template<typename T>
+        Register makeRegister(T value) {
+            if constexpr (std::same_as<T, u128>)
+                return { ValueType::Unsigned, value };
+            else if constexpr (std::same_as<T, i128>)
+                return { ValueType::Signed, u128(value) };
+            else if constexpr (std::same_as<T, bool>)
+                return { ValueType::Boolean, u128(value) };
+            else if constexpr (std::same_as<T, char>)
+                return { ValueType::Character, u128(i128(value)) };
+        }
+
+        template<typename F>
+        bool visitRegister(const Register &reg, F &&callback) {
+            switch (reg.type) {
+                case ValueType::Unsigned:   return callback(u128(reg.bits));
+                case ValueType::Signed:     return callback(i128(reg.bits));
+                case ValueType::Boolean:    return callback(reg.bits != 0);
+                case ValueType::Character:  return callback(char(reg.bits));
+            }
+
+            std::unreachable();
+        }
+
+        Token::Literal toLiteral(const Register &reg) {
+            switch (reg.type) {
+                case ValueType::Unsigned:   return u128(reg.bits);
+                case ValueType::Signed:     return i128(reg.bits);
+                case ValueType::Boolean:    return reg.bits != 0;
+                case ValueType::Character:  return char(reg.bits);
+            }
+
+            std::unreachable();
+        }
+
+        // Same result types as ASTNodeMathematicalExpression: unsigned wins over signed, only two booleans stay a boolean
+        template<typename L, typename R>
+        using ResultType = std::conditional_t<std::same_as<L, u128> || std::same_as<R, u128>, u128,
+                           std::conditional_t<std::same_as<L, bool> && std::same_as<R, bool>, bool, i128>>;
+
+        // Mirrors ASTNodeMathematicalExpression::evaluate(). Returns false for everything that has to be handled, or reported, by the tree walking evaluator
+        template<typename L, typename R>
+        bool applyOperator(Token::Operator op, L left, R right, Register &result) {
+            using T = ResultType<L, R>;
+            constexpr bool leftSigned = is_signed<L>::value;
+            constexpr bool bothSigned = is_signed<L>::value && is_signed<R>::value;
+
+            switch (op) {
+                case Token::Operator::Plus:
+                    result = makeRegister(T(T(left) + T(right)));
+                    return true;
+                case Token::Operator::Minus:
+                    result = makeRegister(T(T(left) - T(right)));
+                    return true;
+                case Token::Operator::Star:
+                    result = makeRegister(T(T(left) * T(right)));
+                    return true;
+                case Token::Operator::Slash:
+                    if constexpr (std::same_as<T, bool>)
+                        return false;
+                    else {
+                        if (right == 0)
+                            return false;
+
+                        result = makeRegister(T(T(left) / T(right)));
+                        return true;
+                    }
+                case Token::Operator::Percent:
+                    if constexpr (std::same_as<T, bool>)
+                        return false;
+                    else {
+                        if (right == 0)
+                            return false;
+
+                        if constexpr (bothSigned)
+                            result = makeRegister(T(i128(left) % i128(right)));
+                        else
+                            result = makeRegister(T(u128(left) % u128(right)));
+                        return true;
+                    }
+                case Token::Operator::LeftShift:
+                    if (u128(right) >= 128)
+                        return false;
+
+                    if constexpr (bothSigned)
+                        result = makeRegister(T(i128(left) << u64(right)));
+                    else
+                        result = makeRegister(T(u128(left) << u64(right)));
+                    return true;
+                case Token::Operator::RightShift:
+                    if (u128(right) >= 128)
+                        return false;
+
+                    if constexpr (leftSigned)
+                        result = makeRegister(T(i128(left) >> u64(right)));
+                    else
+                        result = makeRegister(T(u128(left) >> u64(right)));
+                    return true;
+                case Token::Operator::BitAnd:
+                    if constexpr (bothSigned)
+                        result = makeRegister(T(i128(left) & i128(right)));
+                    else
+                        result = makeRegister(T(u128(left) & u128(right)));
+                    return true;
+                case Token::Operator::BitOr:
+                    if constexpr (bothSigned)
+                        result = makeRegister(T(i128(left) | i128(right)));
+                    else
+                        result = makeRegister(T(u128(left) | u128(right)));
+                    return true;
+                case Token::Operator::BitXor:
+                    if constexpr (bothSigned)
+                        result = makeRegister(T(i128(left) ^ i128(right)));
+                    else
+                        result = makeRegister(T(u128(left) ^ u128(right)));
+                    return true;
+                case Token::Operator::BitNot:
+                    result = makeRegister(T(~u128(right)));
+                    return true;
+                case Token::Operator::BoolEqual:
+                    result = makeRegister(bool(left == static_cast<L>(right)));
+                    return true;
+                case Token::Operator::BoolNotEqual:
+                    result = makeRegister(bool(left != static_cast<L>(right)));
+                    return true;
+                case Token::Operator::BoolGreaterThan:
+                    result = makeRegister(bool(left > static_cast<L>(right)));
+                    return true;
+                case Token::Operator::BoolLessThan:
+                    result = makeRegister(bool(left < static_cast<L>(right)));
+                    return true;
+                case Token::Operator::BoolGreaterThanOrEqual:
+                    result = makeRegister(bool(left >= static_cast<L>(right)));
+                    return true;
+                case Token::Operator::BoolLessThanOrEqual:
+                    result = makeRegister(bool(left <= static_cast<L>(right)));
+                    return true;
+                case Token::Operator::BoolAnd:
+                    result = makeRegister(bool(left && right));
+                    return true;
+                case Token::Operator::BoolXor:
+                    result = makeRegister(bool((left && !right) || (!left && right)));
+                    return true;
+                case Token::Operator::BoolOr:
+                    result = makeRegister(bool(left || right));
+                    return true;
+                case Token::Operator::BoolNot:
+                    result = makeRegister(bool(!right));
+                    return true;
+                default:
+                    return false;
+            }
+        }
+
+        bool applyBinary(Token::Operator op, const Register &left, const Register &right, Register &result) {
+            return visitRegister(left, [&](auto leftValue) {
+                return visitRegister(right, [&](auto rightValue) {
+                    return applyOperator(op, leftValue, rightValue, result);
+                });
+            });
+        }
+
+        template<typename T>
+        bool readVariable(Evaluator *evaluator, T &value, const ptrn::Pattern *pattern) {
+            if (pattern->getSize() > sizeof(T))
+                return false;
+
+            evaluator->readData(pattern->getOffset(), &value, pattern->getSize(), pattern->getSection());
+            value = hlp::changeEndianess(value, pattern->getSize(), pattern->getEndian());
+
+            return true;
+        }
+
+        hlp::StringInterner::Id internVariableName(const std::string &name) {
+            static std::mutex mutex;
+            static hlp::StringInterner interner;
+
+            std::scoped_lock lock(mutex);
+            return interner.intern(name);
+        }
+
+        // Mirrors ASTNodeRValue::evaluate() for plain integral variables
+        bool loadVariable(Evaluator *evaluator, const Variable &variable, Register &result) {
+            if (const auto &parameterPack = evaluator->getScope(0).parameterPack; parameterPack.has_value() && parameterPack->name == variable.name)
+                return false;
+
+            // Names that haven't been resolved by this evaluator yet are looked up by their name, which also interns names of patterns from other runtimes
+            const auto nameId = evaluator->getProgramNameId(variable.nameId, variable.name);
+            const auto found = nameId != hlp::StringInterner::None ? evaluator->findVariable(nameId) : evaluator->findVariable(variable.name);
+            if (found == nullptr || *found == nullptr)
+                return false;
+
+            const auto pattern = found->get();
+            if (pattern->getPatternKind() == ptrn::PatternKind::Pointer)
+                return false;
+            if (const auto transformFunction = pattern->getTransformFunction(); !transformFunction.empty() && evaluator->getFunction(transformFunction) != nullptr)
+                return false;
+
+            switch (pattern->getPatternKind()) {
+                case ptrn::PatternKind::Unsigned: {
+                    u128 value = 0;
+                    if (!readVariable(evaluator, value, pattern))
+                        return false;
+
+                    result = makeRegister(value);
+                    break;
+                }
+                case ptrn::PatternKind::Signed: {
+                    i128 value = 0;
+                    if (!readVariable(evaluator, value, pattern))
+                        return false;
+
+                    result = makeRegister(hlp::signExtend(pattern->getSize() * 8, value));
+                    break;
+                }
+                case ptrn::PatternKind::Character: {
+                    char value = 0;
+                    if (!readVariable(evaluator, value, pattern))
+                        return false;
+
+                    result = makeRegister(value);
+                    break;
+                }
+                case ptrn::PatternKind::Boolean: {
+                    bool value = false;
+                    if (!readVariable(evaluator, value, pattern))
+                        return false;
+
+                    result = makeRegister(value);
+                    break;
+                }
+                default:
+                    return false;
+            }
+
+            return true;
+        }
+
+    }
+
+    class Compiler {
+    public:
+        explicit Compiler(Program &program) : m_program(program) { }
+
+        std::optional<u16> compile(const ast::ASTNode *node) {
+            if (node == nullptr)
+                return std::nullopt;
+
+            if (auto literal = dynamic_cast<const ast::ASTNodeLiteral *>(node); literal != nullptr)
+                return this->compileLiteral(literal->getValue());
+            else if (auto rvalue = dynamic_cast<const ast::ASTNodeRValue *>(node); rvalue != nullptr)
+                return this->compileRValue(*rvalue);
+            else if (auto expression = dynamic_cast<const ast::ASTNodeMathematicalExpression *>(node); expression != nullptr)
+                return this->compileMathematicalExpression(*expression);
+            else if (auto ternary = dynamic_cast<const ast::ASTNodeTernaryExpression *>(node); ternary != nullptr)
+                return this->compileTernaryExpression(*ternary);
+            else if (auto typeOperator = dynamic_cast<const ast::ASTNodeTypeOperator *>(node); typeOperator != nullptr && typeOperator->getConstantValue().has_value())
+                return this->compileLiteral(*typeOperator->getConstantValue());
+            else
+                return std::nullopt;
+        }
+
+    private:
+        std::optional<u16> allocateRegister() {
+            if (this->m_program.m_registerCount >= Program::MaxRegisterCount)
+                return std::nullopt;
+
+            return this->m_program.m_registerCount++;
+        }
+
+        size_t emit(OpCode opCode, u16 destination, u16 left = 0, u16 right = 0, u32 operand = 0, Token::Operator op = Token::Operator::Plus) {
+            this->m_program.m_instructions.push_back({ opCode, op, destination, left, right, operand });
+
+            return this->m_program.m_instructions.size() - 1;
+        }
+
+        void patchJump(size_t instruction) {
+            this->m_program.m_instructions[instruction].operand = u32(this->m_program.m_instructions.size());
+        }
+
+        std::optional<u16> compileLiteral(const Token::Literal &literal) {
+            auto value = std::visit(wolv::util::overloaded {
+                [](char value) -> std::optional<Register> { return makeRegister(value); },
+                [](bool value) -> std::optional<Register> { return makeRegister(value); },
+                [](u128 value) -> std::optional<Register> { return makeRegister(value); },
+                [](i128 value) -> std::optional<Register> { return makeRegister(value); },
+                [](const auto &) -> std::optional<Register> { return std::nullopt; }
+            }, literal);
+
+            if (!value.has_value())
+                return std::nullopt;
+
+            auto destination = this->allocateRegister();
+            if (!destination.has_value())
+                return std::nullopt;
+
+            this->m_program.m_constants.push_back(*value);
+            this->emit(OpCode::LoadConstant, *destination, 0, 0, u32(this->m_program.m_constants.size() - 1));
+
+            return destination;
+        }
+
+        std::optional<u16> compileRValue(const ast::ASTNodeRValue &rvalue) {
+            const auto &path = rvalue.getPath();
+            if (path.size() != 1)
+                return std::nullopt;
+
+            const auto name = std::get_if<std::string>(&path.front());
+            if (name == nullptr || *name == "null" || *name == "this" || *name == "parent")
+                return std::nullopt;
+
+            auto destination = this->allocateRegister();
+            if (!destination.has_value())
+                return std::nullopt;
+
+            if (*name == "$") {
+                this->emit(OpCode::LoadOffset, *destination);
+            } else {
+                this->m_program.m_variables.push_back({ *name, internVariableName(*name) });
+                this->emit(OpCode::LoadVariable, *destination, 0, 0, u32(this->m_program.m_variables.size() - 1));
+            }
+
+            return destination;
+        }
+
+        std::optional<u16> compileMathematicalExpression(const ast::ASTNodeMathematicalExpression &expression) {
+            using enum Token::Operator;
+
+            if (const auto &value = expression.getConstantValue(); value.has_value())
+                return this->compileLiteral(*value);
+
+            const auto op = expression.getOperator();
+            switch (op) {
+                case Plus: case Minus: case Star: case Slash: case Percent:
+                case LeftShift: case RightShift: case BitAnd: case BitOr: case BitXor: case BitNot:
+                case BoolEqual: case BoolNotEqual: case BoolGreaterThan: case BoolLessThan: case BoolGreaterThanOrEqual: case BoolLessThanOrEqual:
+                case BoolAnd: case BoolXor: case BoolOr: case BoolNot:
+                    break;
+                default:
+                    return std::nullopt;
+            }
+
+            auto left = this->compile(expression.getLeftOperand().get());
+            if (!left.has_value())
+                return std::nullopt;
+
+            auto destination = this->allocateRegister();
+            if (!destination.has_value())
+                return std::nullopt;
+
+            // Logical and and or only evaluate their right operand if the left one didn't decide the result already
+            std::optional<size_t> shortCircuit;
+            if (op == BoolAnd || op == BoolOr) {
+                this->emit(OpCode::ToBoolean, *destination, *left);
+                shortCircuit = this->emit(op == BoolAnd ? OpCode::JumpIfFalse : OpCode::JumpIfTrue, 0, *destination);
+            }
+
+            auto right = this->compile(expression.getRightOperand().get());
+            if (!right.has_value())
+                return std::nullopt;
+
+            this->emit(OpCode::Binary, *destination, *left, *right, 0, op);
+
+            if (shortCircuit.has_value())
+                this->patchJump(*shortCircuit);
+
+            return destination;
+        }
+
+        std::optional<u16> compileTernaryExpression(const ast::ASTNodeTernaryExpression &expression) {
+            if (const auto &value = expression.getConstantValue(); value.has_value())
+                return this->compileLiteral(*value);
+
+            auto condition = this->compile(expression.getFirstOperand().get());
+            if (!condition.has_value())
+                return std::nullopt;
+
+            auto destination = this->allocateRegister();
+            if (!destination.has_value())
+                return std::nullopt;
+
+            const auto jumpToFalse = this->emit(OpCode::JumpIfFalse, 0, *condition);
+
+            auto trueValue = this->compile(expression.getSecondOperand().get());
+            if (!trueValue.has_value())
+                return std::nullopt;
+            this->emit(OpCode::Move, *destination, *trueValue);
+            const auto jumpToEnd = this->emit(OpCode::Jump, 0);
+
+            this->patchJump(jumpToFalse);
+            auto falseValue = this->compile(expression.getThirdOperand().get());
+            if (!falseValue.has_value())
+                return std::nullopt;
+            this->emit(OpCode::Move, *destination, *falseValue);
+
+            this->patchJump(jumpToEnd);
+
+            return destination;
+        }
+
+    private:
+        Program &m_program;
+    };
+
+    std::unique_ptr<Program> Program::compile(const ast::ASTNode *expression) {
+        auto program = std::make_unique<Program>();
+
+        Compiler compiler(*program);
+        auto result = compiler.compile(expression);
+        if (!result.has_value())
+            return nullptr;
+
+        program->m_result = *result;
+
+        return program;
+    }
+
+    bool Program::isConstant() const {
+        return std::ranges::none_of(this->m_instructions, [](const Instruction &instruction) {
+            return instruction.opCode == OpCode::LoadVariable || instruction.opCode == OpCode::LoadOffset;
+        });
+    }
+
+    std::optional<Token::Literal> Program::execute(Evaluator *evaluator) const {
+        std::array<Register, MaxRegisterCount> registers = { };
+
+        using enum OpCode;
+
+        const auto instructionCount = this->m_instructions.size();
+        for (size_t pc = 0; pc < instructionCount;) {
+            const auto &instruction = this->m_instructions[pc];
+            pc += 1;
+
+            switch (instruction.opCode) {
+                case LoadConstant:
+                    registers[instruction.destination] = this->m_constants[instruction.operand];
+                    break;
+                case LoadVariable:
+                    if (!loadVariable(evaluator, this->m_variables[instruction.operand], registers[instruction.destination]))
+                        return std::nullopt;
+                    break;
+                case LoadOffset:
+                    registers[instruction.destination] = makeRegister(u128(evaluator->getReadOffset()));
+                    break;
+                case Move:
+                    registers[instruction.destination] = registers[instruction.left];
+                    break;
+                case ToBoolean:
+                    registers[instruction.destination] = makeRegister(registers[instruction.left].bits != 0);
+                    break;
+                case Binary: {
+                    Register result = { };
+                    if (!applyBinary(instruction.op, registers[instruction.left], registers[instruction.right], result))
+                        return std::nullopt;
+
+                    registers[instruction.destination] = result;
+                    break;
+                }
+                case Jump:
+                    pc = instruction.operand;
+                    break;
+                case JumpIfFalse:
+                    if (registers[instruction.left].bits == 0)
+                        pc = instruction.operand;
+                    break;
+                case JumpIfTrue:
+                    if (registers[instruction.left].bits != 0)
+                        pc = instruction.operand;
+                    break;
+            }
+        }
+
+        return toLiteral(registers[this->m_result]);
+    }
+
+    std::optional<Token::Literal> CompiledExpression::execute(Evaluator *evaluator, const ast::ASTNode *expression) const {
+        std::call_once(this->m_compiled, [&] {
+            this->m_program = Program::compile(expression);
+        });
+
+        // Expressions that can't be compiled always go through the tree walking evaluator
+        if (this->m_program == nullptr)
+            return std::nullopt;
+
+        // The program may still hand over to the tree walking evaluator for values it can't handle. The AST is shared between
+        // runtimes, so that only ever affects this one call
+        return this->m_program->execute(evaluator);
+    }
+
+}
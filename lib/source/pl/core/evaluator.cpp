@@ -21,11 +21,16 @@
 #include <pl/patterns/pattern_character.hpp>
 #include <pl/patterns/pattern_wide_character.hpp>
 #include <pl/patterns/pattern_string.hpp>
+#include <pl/patterns/pattern_wide_string.hpp>
+#include <pl/patterns/pattern_array_static.hpp>
 #include <pl/patterns/pattern_array_dynamic.hpp>
 #include <pl/patterns/pattern_padding.hpp>
+#include <pl/patterns/pattern_struct.hpp>
+#include <pl/patterns/pattern_bitfield.hpp>
 #include <pl/patterns/pattern_error.hpp>
 
 #include <exception>
+#include <ranges>
 #include <utility>
 #include "wolv/utils/string.hpp"
 
@@ -38,6 +43,7 @@ namespace pl::core {
     void Evaluator::setDataSource(u64 baseAddress, size_t dataSize, std::function<void(u64, u8*, size_t)> readerFunction, std::optional<std::function<void(u64, const u8*, size_t)>> writerFunction) {
         this->m_dataBaseAddress = baseAddress;
         this->m_dataSize = dataSize;
+        this->m_dataSpan = { };
 
         this->m_readerFunction = [this, readerFunction = std::move(readerFunction)](u64 offset, u8* buffer, size_t size) {
             this->m_lastReadAddress = offset;
@@ -54,6 +60,25 @@ namespace pl::core {
         }
     }
 
+    void Evaluator::setDataSource(u64 baseAddress, size_t dataSize, std::span<const u8> data, u64 dataAddress, std::optional<std::function<void(u64, const u8*, size_t)>> writerFunction) {
+        this->m_dataBaseAddress = baseAddress;
+        this->m_dataSize = dataSize;
+        this->m_dataSpan = data;
+        this->m_dataSpanAddress = dataAddress;
+
+        this->m_readerFunction = [](u64, u8*, size_t) {
+            err::E0011.throwError("Reads should be served from the attached memory. This is a bug.");
+        };
+
+        if (writerFunction.has_value()) {
+            this->m_writerFunction = [this, writerFunction = std::move(writerFunction.value())](u64 offset, const u8* buffer, size_t size) {
+                this->m_lastWriteAddress = offset;
+
+                writerFunction(offset, buffer, size);
+            };
+        }
+    }
+
     void Evaluator::alignToByte() {
         if (m_currBitOffset != 0 && !isReadOrderReversed()) {
             this->m_currOffset += 1;
@@ -156,6 +181,9 @@ namespace pl::core {
             }
         });
 
+        if (inserted)
+            this->m_functionGeneration += 1;
+
         return inserted;
     }
 
@@ -178,22 +206,150 @@ namespace pl::core {
             name, {numParams, std::move(defaultParameters), function}
         });
 
+        if (inserted)
+            this->m_functionGeneration += 1;
+
         return inserted;
     }
 
     [[nodiscard]] std::optional<api::Function> Evaluator::findFunction(const std::string &name) const {
-        if (name.empty())
+        if (auto function = this->getFunction(name); function != nullptr)
+            return *function;
+        else
             return std::nullopt;
+    }
+
+    [[nodiscard]] const api::Function* Evaluator::getFunction(const std::string &name) const {
+        if (name.empty())
+            return nullptr;
 
         const auto &customFunctions     = this->getCustomFunctions();
         const auto &builtinFunctions    = this->getBuiltinFunctions();
 
         if (auto customFunction = customFunctions.find(name); customFunction != customFunctions.end())
-            return customFunction->second;
+            return &customFunction->second;
         else if (auto builtinFunction = builtinFunctions.find(name); builtinFunction != builtinFunctions.end())
-            return builtinFunction->second;
+            return &builtinFunction->second;
         else
-            return std::nullopt;
+            return nullptr;
+    }
+
+    [[nodiscard]] const api::Function* Evaluator::getCallTarget(u64 callSiteId, const std::string &name) {
+        // Functions are never moved in memory once added, so resolved targets stay valid until functions get added or removed.
+        // Adding a custom function may shadow a builtin one that was resolved before
+        if (this->m_callTargetGeneration != this->m_functionGeneration) {
+            this->m_callTargets.clear();
+            this->m_callTargetGeneration = this->m_functionGeneration;
+        }
+
+        // Call site ids are never reused, so a hit always belongs to a call of the same function
+        if (auto it = this->m_callTargets.find(callSiteId); it != this->m_callTargets.end())
+            return it->second;
+
+        auto function = this->getFunction(name);
+        if (function != nullptr)
+            this->m_callTargets.emplace(callSiteId, function);
+
+        return function;
+    }
+
+    bool Evaluator::canUseLayoutTemplates() const {
+        // Copying a template skips evaluating the members, so don't do it while someone may want to step through them
+        if (!this->m_breakpoints.empty() || this->m_shouldPauseNextLine)
+            return false;
+
+        if (this->m_readOrderReversed || this->m_currBitOffset != 0)
+            return false;
+
+        const auto sectionId = this->getSectionId();
+        return sectionId != ptrn::Pattern::PatternLocalSectionId && sectionId != ptrn::Pattern::HeapSectionId && sectionId != ptrn::Pattern::InstantiationSectionId;
+    }
+
+    std::shared_ptr<ptrn::Pattern> Evaluator::instantiateLayoutTemplate(const ast::ASTNodeTypeDecl *type) {
+        auto it = this->m_layoutTemplates.find({ type, this->m_defaultEndian, this->getSectionId() });
+        if (it == this->m_layoutTemplates.end() || it->second == nullptr)
+            return nullptr;
+
+        auto pattern = it->second->clone();
+        pattern->setOffset(this->m_currOffset);
+        this->assignPatternColors(pattern.get());
+
+        return pattern;
+    }
+
+    void Evaluator::setLayoutTemplate(const ast::ASTNodeTypeDecl *type, const std::shared_ptr<ptrn::Pattern> &pattern, u32 paletteIndex) {
+        // Types that can't be turned into a template are only checked once, they're created one by one from then on
+        auto [it, inserted] = this->m_layoutTemplates.try_emplace({ type, this->m_defaultEndian, this->getSectionId() }, nullptr);
+        if (!inserted)
+            return;
+
+        // Only keep the template if instantiating it hands out the exact same colors as creating the pattern did
+        auto layoutTemplate = pattern->clone();
+        const auto endPaletteIndex = this->m_patternColorPaletteIndex;
+
+        this->m_patternColorPaletteIndex = paletteIndex;
+        this->assignPatternColors(layoutTemplate.get());
+
+        const bool sameColors = this->m_patternColorPaletteIndex == endPaletteIndex && getPatternColors(layoutTemplate.get()) == getPatternColors(pattern.get());
+        this->m_patternColorPaletteIndex = endPaletteIndex;
+
+        if (sameColors)
+            it->second = std::move(layoutTemplate);
+    }
+
+    void Evaluator::assignPatternColors(ptrn::Pattern *pattern) {
+        // Hand out colors in the same order as creating the patterns one by one would. Every created pattern takes a color, even if it gets overridden later
+        const auto takeColor = [this](ptrn::Pattern *pattern) {
+            const auto color = this->getNextPatternColor();
+            if (!pattern->hasOverriddenColor())
+                pattern->setBaseColor(color);
+        };
+
+        if (auto staticArray = ptrn::pattern_cast<ptrn::PatternArrayStatic>(pattern); staticArray != nullptr) {
+            // The entry template is created before the array
+            this->assignPatternColors(staticArray->getTemplate().get());
+            takeColor(staticArray);
+            staticArray->getTemplate()->setBaseColor(staticArray->getColor());
+        } else if (ptrn::pattern_cast<ptrn::PatternString>(pattern) != nullptr || ptrn::pattern_cast<ptrn::PatternWideString>(pattern) != nullptr || ptrn::pattern_cast<ptrn::PatternPadding>(pattern) != nullptr) {
+            // Arrays of characters and padding create a single entry first and then replace it with the string
+            this->getNextPatternColor();
+            takeColor(pattern);
+        } else if (ptrn::pattern_cast<ptrn::PatternEnum>(pattern) != nullptr) {
+            // Enums create a pattern of their underlying type first
+            this->getNextPatternColor();
+            takeColor(pattern);
+        } else {
+            takeColor(pattern);
+
+            std::vector<std::shared_ptr<ptrn::Pattern>> members;
+            if (auto structPattern = ptrn::pattern_cast<ptrn::PatternStruct>(pattern); structPattern != nullptr)
+                members = structPattern->getEntries();
+            else if (auto bitfieldPattern = ptrn::pattern_cast<ptrn::PatternBitfield>(pattern); bitfieldPattern != nullptr)
+                members = bitfieldPattern->getEntries();
+
+            for (const auto &member : members)
+                this->assignPatternColors(member.get());
+
+            if (!members.empty())
+                pattern->setBaseColor(members.front()->getColor());
+        }
+    }
+
+    std::vector<u32> Evaluator::getPatternColors(ptrn::Pattern *pattern) {
+        std::vector<u32> colors = { pattern->getColor() };
+
+        std::vector<std::shared_ptr<ptrn::Pattern>> members;
+        if (auto staticArray = ptrn::pattern_cast<ptrn::PatternArrayStatic>(pattern); staticArray != nullptr)
+            members = { staticArray->getTemplate() };
+        else if (auto structPattern = ptrn::pattern_cast<ptrn::PatternStruct>(pattern); structPattern != nullptr)
+            members = structPattern->getEntries();
+        else if (auto bitfieldPattern = ptrn::pattern_cast<ptrn::PatternBitfield>(pattern); bitfieldPattern != nullptr)
+            members = bitfieldPattern->getEntries();
+
+        for (const auto &member : members)
+            std::ranges::copy(getPatternColors(member.get()), std::back_inserter(colors));
+
+        return colors;
     }
 
     void Evaluator::createParameterPack(const std::string &name, const std::vector<Token::Literal> &values) {
@@ -293,12 +449,8 @@ namespace pl::core {
                 return var->getVariableName() == name;
             });
         } else {
-            auto &currScope = this->getScope(0);
-            for (auto &variable : *currScope.scope) {
-                if (variable->getVariableName() == name) {
-                    err::E0003.throwError(fmt::format("Variable with name '{}' already exists in this scope.", name), {}, type->getLocation());
-                }
-            }
+            if (this->findVariable(this->getScope(0), name) != nullptr)
+                err::E0003.throwError(fmt::format("Variable with name '{}' already exists in this scope.", name), {}, type->getLocation());
         }
 
         auto sectionId = this->getSectionId();
@@ -325,19 +477,19 @@ namespace pl::core {
         if (auto builtinType = dynamic_cast<const ast::ASTNodeBuiltinType*>(typeDefinition); builtinType != nullptr && builtinType->getType() == Token::ValueType::Auto) {
             // Handle auto variables
             if (!value.has_value())
-                pattern = std::make_shared<ptrn::PatternPadding>(this, 0, 0, 0);
+                pattern = this->createPattern<ptrn::PatternPadding>(0, 0, 0);
             else if (std::get_if<u128>(&value.value()) != nullptr)
-                pattern = std::make_shared<ptrn::PatternUnsigned>(this, 0, sizeof(u128), 0);
+                pattern = this->createPattern<ptrn::PatternUnsigned>(0, sizeof(u128), 0);
             else if (std::get_if<i128>(&value.value()) != nullptr)
-                pattern = std::make_shared<ptrn::PatternSigned>(this, 0, sizeof(i128), 0);
+                pattern = this->createPattern<ptrn::PatternSigned>(0, sizeof(i128), 0);
             else if (std::get_if<double>(&value.value()) != nullptr)
-                pattern = std::make_shared<ptrn::PatternFloat>(this, 0, sizeof(double), 0);
+                pattern = this->createPattern<ptrn::PatternFloat>(0, sizeof(double), 0);
             else if (std::get_if<bool>(&value.value()) != nullptr)
-                pattern = std::make_shared<ptrn::PatternBoolean>(this, 0, 0);
+                pattern = this->createPattern<ptrn::PatternBoolean>(0, 0);
             else if (std::get_if<char>(&value.value()) != nullptr)
-                pattern = std::make_shared<ptrn::PatternCharacter>(this, 0, 0);
+                pattern = this->createPattern<ptrn::PatternCharacter>(0, 0);
             else if (auto string = std::get_if<std::string>(&value.value()); string != nullptr)
-                pattern = std::make_shared<ptrn::PatternString>(this, 0, string->size(), 0);
+                pattern = this->createPattern<ptrn::PatternString>(0, string->size(), 0);
             else if (auto patternValue = std::get_if<std::shared_ptr<ptrn::Pattern>>(&value.value()); patternValue != nullptr) {
                 if (reference && !templateVariable)
                     pattern = *patternValue;
@@ -353,7 +505,7 @@ namespace pl::core {
                 pattern = std::move(patterns.front());
             }
             else {
-                pattern = std::make_shared<ptrn::PatternPadding>(this, 0, 0, 0);
+                pattern = this->createPattern<ptrn::PatternPadding>(0, 0, 0);
                 pattern->setTypeName(type->getTypeName());
             }
         }
@@ -404,30 +556,33 @@ namespace pl::core {
     }
 
     static Token::Literal castLiteral(const ptrn::Pattern *pattern, const Token::Literal &literal) {
+        using enum ptrn::PatternKind;
+        const auto kind = pattern->getPatternKind();
+
         return std::visit(wolv::util::overloaded {
             [&](auto &value) -> Token::Literal {
-               if (dynamic_cast<const ptrn::PatternUnsigned*>(pattern) || dynamic_cast<const ptrn::PatternEnum*>(pattern))
+               if (kind == Unsigned || kind == Enum)
                    return truncateValue<u128>(pattern->getSize(), u128(value));
-               else if (dynamic_cast<const ptrn::PatternSigned*>(pattern))
+               else if (kind == Signed)
                    return truncateValue<i128>(pattern->getSize(), i128(value));
-               else if (dynamic_cast<const ptrn::PatternFloat*>(pattern)) {
+               else if (kind == Float) {
                    if (pattern->getSize() == sizeof(float))
                        return double(float(value));
                    else
                        return double(value);
-               } else if (dynamic_cast<const ptrn::PatternBoolean*>(pattern))
+               } else if (kind == Boolean)
                    return value == 0 ? u128(0) : u128(1);
-               else if (dynamic_cast<const ptrn::PatternCharacter*>(pattern) || dynamic_cast<const ptrn::PatternWideCharacter*>(pattern))
+               else if (kind == Character || kind == WideCharacter)
                    return truncateValue(pattern->getSize(), u128(value));
-               else if (dynamic_cast<const ptrn::PatternString*>(pattern))
+               else if (kind == String)
                    return Token::Literal(value).toString(false);
-               else if (dynamic_cast<const ptrn::PatternPadding*>(pattern))
+               else if (kind == Padding)
                    return value;
                else
                    err::E0004.throwError(fmt::format("Cannot cast from type 'integer' to type '{}'.", pattern->getTypeName()));
             },
             [&](const std::string &value) -> Token::Literal {
-                if (dynamic_cast<const ptrn::PatternUnsigned*>(pattern) != nullptr) {
+                if (kind == Unsigned) {
                     if (value.size() <= pattern->getSize()) {
                         u128 result = 0;
                         std::memcpy(&result, value.data(), value.size());
@@ -435,11 +590,11 @@ namespace pl::core {
                     } else {
                         err::E0004.throwError(fmt::format("String of size {} cannot be packed into integer of size {}", value.size(), pattern->getSize()));
                     }
-                } else if (dynamic_cast<const ptrn::PatternBoolean*>(pattern) != nullptr)
+                } else if (kind == Boolean)
                     return !value.empty();
-                else if (dynamic_cast<const ptrn::PatternString*>(pattern) != nullptr)
+                else if (kind == String)
                     return value;
-                else if (dynamic_cast<const ptrn::PatternPadding*>(pattern) != nullptr)
+                else if (kind == Padding)
                     return value;
                 else
                     err::E0004.throwError(fmt::format("Cannot cast from type 'string' to type '{}'.", pattern->getTypeName()));
@@ -467,17 +622,140 @@ namespace pl::core {
         }
     }
 
-    std::shared_ptr<ptrn::Pattern>& Evaluator::getVariableByName(const std::string &name) {
-        // Search for variable in current scope
-        {
-            auto &variables = *this->getScope(0).scope;
-            for (auto &variable : variables) {
-                if (variable->getVariableName() == name) {
-                    return variable;
-                }
+    hlp::StringInterner::Id Evaluator::getVariableNameId(const ptrn::Pattern &pattern) {
+        if (!pattern.hasVariableName())
+            return hlp::StringInterner::None;
+
+        // Patterns created by other runtimes have their names interned by a different evaluator
+        if (pattern.getEvaluator() == this)
+            return pattern.getVariableNameId();
+        else
+            return this->m_stringInterner.intern(pattern.getVariableName());
+    }
+
+    hlp::StringInterner::Id Evaluator::getProgramNameId(hlp::StringInterner::Id programNameId, const std::string &name) {
+        if (programNameId < this->m_programNameIds.size() && this->m_programNameIds[programNameId] != hlp::StringInterner::None)
+            return this->m_programNameIds[programNameId];
+
+        // Names only get interned once a variable is given them, so only remember ids that exist already
+        const auto id = this->m_stringInterner.find(name);
+        if (id != hlp::StringInterner::None) {
+            if (programNameId >= this->m_programNameIds.size())
+                this->m_programNameIds.resize(programNameId + 1, hlp::StringInterner::None);
+
+            this->m_programNameIds[programNameId] = id;
+        }
+
+        return id;
+    }
+
+    std::shared_ptr<ptrn::Pattern>* Evaluator::findVariable(Scope &scope, const std::string &name) {
+        // Indexing the scope may intern names of patterns that were created by other runtimes, so only look up the name's id afterwards
+        this->indexScope(scope);
+
+        return this->findVariable(scope, this->m_stringInterner.find(name));
+    }
+
+    void Evaluator::indexScope(Scope &scope) {
+        auto &patterns = *scope.scope;
+
+        // Start over if variables were renamed or removed since the index was built
+        if (scope.indexGeneration != this->m_variableNameGeneration || patterns.size() < scope.indexedEntries) {
+            scope.nameIndex.clear();
+            scope.unnamedEntries.clear();
+            scope.indexedEntries = 0;
+            scope.indexGeneration = this->m_variableNameGeneration;
+        }
+
+        // Index all variables that were added since the last lookup. Later variables shadow earlier ones with the same name
+        for (; scope.indexedEntries < patterns.size(); scope.indexedEntries += 1) {
+            const auto &pattern = patterns[scope.indexedEntries];
+            if (pattern == nullptr)
+                continue;
+
+            if (const auto id = this->getVariableNameId(*pattern); id != hlp::StringInterner::None)
+                scope.nameIndex[id] = scope.indexedEntries;
+            else
+                scope.unnamedEntries.push_back(scope.indexedEntries);
+        }
+    }
+
+    std::shared_ptr<ptrn::Pattern>* Evaluator::findVariable(Scope &scope, hlp::StringInterner::Id id) {
+        auto &patterns = *scope.scope;
+
+        this->indexScope(scope);
+
+        // A name that has never been interned can't belong to any variable
+        if (id == hlp::StringInterner::None)
+            return nullptr;
+
+        if (auto it = scope.nameIndex.find(id); it != scope.nameIndex.end()) {
+            auto &pattern = patterns[it->second];
+            if (pattern != nullptr && this->getVariableNameId(*pattern) == id)
+                return &pattern;
+
+            // The variable got replaced without the index noticing. Fall back to searching the whole scope and rebuild the index next time
+            scope.indexGeneration = this->m_variableNameGeneration - 1;
+            for (auto &variable : patterns | std::views::reverse) {
+                if (variable != nullptr && this->getVariableNameId(*variable) == id)
+                    return &variable;
             }
+
+            return nullptr;
+        }
+
+        // Variables that didn't have a name yet when they were indexed
+        for (const auto index : scope.unnamedEntries | std::views::reverse) {
+            auto &pattern = patterns[index];
+            if (pattern != nullptr && this->getVariableNameId(*pattern) == id)
+                return &pattern;
+        }
+
+        return nullptr;
+    }
+
+    std::shared_ptr<ptrn::Pattern>* Evaluator::findVariable(const std::string &name) {
+        // Search the current scope first, then the template parameters and finally the global scope
+        if (auto variable = this->findVariable(this->getScope(0), name); variable != nullptr)
+            return variable;
+
+        auto &templateParameters = this->getTemplateParameters();
+        for (auto &variable : templateParameters | std::views::reverse) {
+            if (variable->getVariableName() == name)
+                return &variable;
         }
 
+        if (!this->isGlobalScope())
+            return this->findVariable(this->getGlobalScope(), name);
+
+        return nullptr;
+    }
+
+    std::shared_ptr<ptrn::Pattern>* Evaluator::findVariable(hlp::StringInterner::Id id) {
+        if (id == hlp::StringInterner::None)
+            return nullptr;
+
+        // Same search order as looking up the variable by its name
+        if (auto variable = this->findVariable(this->getScope(0), id); variable != nullptr)
+            return variable;
+
+        auto &templateParameters = this->getTemplateParameters();
+        for (auto &variable : templateParameters | std::views::reverse) {
+            if (this->getVariableNameId(*variable) == id)
+                return &variable;
+        }
+
+        if (!this->isGlobalScope())
+            return this->findVariable(this->getGlobalScope(), id);
+
+        return nullptr;
+    }
+
+    std::shared_ptr<ptrn::Pattern>& Evaluator::getVariableByName(const std::string &name) {
+        // Search for variable in current scope
+        if (auto variable = this->findVariable(this->getScope(0), name); variable != nullptr)
+            return *variable;
+
         // Search for variable in the template parameter list
         {
             auto &variables = this->m_templateParameters.back();
@@ -489,12 +767,8 @@ namespace pl::core {
         }
 
         // If there's no variable with that name in the current scope, search the global scope
-        auto &variables = *this->getGlobalScope().scope;
-        for (auto &variable : variables) {
-            if (variable->getVariableName() == name) {
-                return variable;
-            }
-        }
+        if (auto variable = this->findVariable(this->getGlobalScope(), name); variable != nullptr)
+            return *variable;
 
         err::E0003.throwError(fmt::format("Cannot find variable '{}' in this scope.", name));
     }
@@ -535,7 +809,7 @@ namespace pl::core {
                         this->changePatternSection(variablePattern.get(), section);
                     },
                     [&](const std::string &value) {
-                        if (dynamic_cast<ptrn::PatternString*>(variablePattern.get()) != nullptr)
+                        if (variablePattern->getPatternKind() == ptrn::PatternKind::String)
                             variablePattern->setSize(value.size());
                         else
                             err::E0004.throwError(fmt::format("Cannot assign value of type 'string' to variable of type '{}'.", variablePattern->getTypeName()));
@@ -566,7 +840,7 @@ namespace pl::core {
     }
 
     void Evaluator::changePatternType(std::shared_ptr<ptrn::Pattern> &pattern, std::shared_ptr<ptrn::Pattern> &&newPattern) const {
-        if (dynamic_cast<ptrn::PatternPadding*>(pattern.get()) == nullptr)
+        if (pattern->getPatternKind() != ptrn::PatternKind::Padding)
             return;
 
         auto section = pattern->getSection();
@@ -614,8 +888,10 @@ namespace pl::core {
 
             auto getStorage = [&, this]() -> auto& {
                 if (heapSection) {
-                    if (auto &heap = this->getHeap(); heap.size() > pattern->getHeapAddress())
+                    if (auto &heap = this->getHeap(); heap.size() > pattern->getHeapAddress()) {
+                        this->journalHeapCell(pattern->getHeapAddress());
                         return heap[pattern->getHeapAddress()];
+                    }
                     else
                         err::E0011.throwError(fmt::format("Tried accessing out of bounds heap cell {}. This is a bug.", pattern->getHeapAddress()));
                 } else if (patternLocalSection) {
@@ -650,32 +926,32 @@ namespace pl::core {
 
             std::visit(wolv::util::overloaded {
                 [&](const u128 &value) {
-                    changePatternType(pattern, std::make_shared<ptrn::PatternUnsigned>(this, 0, 16, 0));
+                    changePatternType(pattern, this->createPattern<ptrn::PatternUnsigned>(0, 16, 0));
 
                     auto adjustedValue = hlp::changeEndianess(value, pattern->getSize(), pattern->getEndian());
                     copyToStorage(adjustedValue);
                 },
                 [&](const i128 &value) {
-                    changePatternType(pattern, std::make_shared<ptrn::PatternSigned>(this, 0, 16, 0));
+                    changePatternType(pattern, this->createPattern<ptrn::PatternSigned>(0, 16, 0));
 
                     auto adjustedValue = hlp::changeEndianess(value, pattern->getSize(), pattern->getEndian());
                     adjustedValue = hlp::signExtend(pattern->getSize() * 8, adjustedValue);
                     copyToStorage(adjustedValue);
                 },
                 [&](const bool &value) {
-                    changePatternType(pattern, std::make_shared<ptrn::PatternBoolean>(this, 0, 0));
+                    changePatternType(pattern, this->createPattern<ptrn::PatternBoolean>(0, 0));
 
                     auto adjustedValue = hlp::changeEndianess(value, pattern->getSize(), pattern->getEndian());
                     copyToStorage(adjustedValue);
                 },
                 [&](const char &value) {
-                    changePatternType(pattern, std::make_shared<ptrn::PatternCharacter>(this, 0, 0));
+                    changePatternType(pattern, this->createPattern<ptrn::PatternCharacter>(0, 0));
 
                     auto adjustedValue = hlp::changeEndianess(value, pattern->getSize(), pattern->getEndian());
                     copyToStorage(adjustedValue);
                 },
                 [&](const double &value) {
-                    changePatternType(pattern, std::make_shared<ptrn::PatternFloat>(this, 0, 8, 0));
+                    changePatternType(pattern, this->createPattern<ptrn::PatternFloat>(0, 8, 0));
 
                     if (pattern->getSize() == sizeof(float)) {
                         auto floatValue = float(value);
@@ -693,7 +969,7 @@ namespace pl::core {
                     }
                 },
                 [&](const std::string &value) {
-                    changePatternType(pattern, std::make_shared<ptrn::PatternString>(this, 0, value.length(), 0));
+                    changePatternType(pattern, this->createPattern<ptrn::PatternString>(0, value.length(), 0));
 
                     pattern->setSize(value.size());
 
@@ -761,6 +1037,12 @@ namespace pl::core {
 
         auto &heap = this->getHeap();
 
+        // Cells that existed when a checkpoint was created need to be restorable even if the scope that created them ends
+        if (!this->m_heapCheckpoints.empty()) {
+            for (auto cell = currScope.heapStartSize; cell < heap.size(); cell += 1)
+                this->journalHeapCell(cell);
+        }
+
         heap.resize(currScope.heapStartSize);
 
         if (this->isDebugModeEnabled())
@@ -769,18 +1051,50 @@ namespace pl::core {
         this->m_scopes.pop_back();
     }
 
-    std::vector<ast::ASTNode*> unpackCompoundStatements(const std::vector<std::shared_ptr<ast::ASTNode>> &nodes) {
-        std::vector<ast::ASTNode*> result;
+    void Evaluator::pushHeapCheckpoint() {
+        this->m_heapCheckpoints.push_back({ this->m_heap.size(), { } });
+    }
+
+    void Evaluator::popHeapCheckpoint() {
+        if (this->m_heapCheckpoints.empty())
+            return;
+
+        auto checkpoint = std::move(this->m_heapCheckpoints.back());
+        this->m_heapCheckpoints.pop_back();
+
+        this->m_heap.resize(checkpoint.heapSize);
+        for (auto &[heapAddress, cell] : checkpoint.savedCells)
+            this->m_heap[heapAddress] = std::move(cell);
+    }
+
+    void Evaluator::journalHeapCell(u64 heapAddress) {
+        if (heapAddress >= this->m_heap.size())
+            return;
+
+        // Every checkpoint keeps the value a cell had when it was created. Cells that were added after that get dropped on restore anyway
+        for (auto &checkpoint : this->m_heapCheckpoints) {
+            if (heapAddress < checkpoint.heapSize)
+                checkpoint.savedCells.try_emplace(heapAddress, this->m_heap[heapAddress]);
+        }
+    }
 
+    static void flattenStatements(const std::vector<std::shared_ptr<ast::ASTNode>> &nodes, std::vector<ast::ASTNode*> &result) {
         for (const auto &node : nodes) {
-            if (auto compoundStatement = dynamic_cast<ast::ASTNodeCompoundStatement*>(node.get()); compoundStatement != nullptr) {
-                auto unpacked = unpackCompoundStatements(compoundStatement->getStatements());
+            if (node == nullptr)
+                continue;
 
-                std::move(unpacked.begin(), unpacked.end(), std::back_inserter(result));
-            } else {
+            if (node->getKind() == ast::ASTNode::Kind::CompoundStatement)
+                flattenStatements(static_cast<ast::ASTNodeCompoundStatement*>(node.get())->getStatements(), result);
+            else
                 result.push_back(node.get());
-            }
         }
+    }
+
+    std::vector<ast::ASTNode*> Evaluator::flattenStatements(const std::vector<std::shared_ptr<ast::ASTNode>> &ast) {
+        std::vector<ast::ASTNode*> result;
+        result.reserve(ast.size());
+
+        core::flattenStatements(ast, result);
 
         return result;
     }
@@ -791,7 +1105,18 @@ namespace pl::core {
 
         if (sectionId == ptrn::Pattern::MainSectionId) [[likely]] {
             if (!write) [[likely]] {
-                this->m_readerFunction(address, static_cast<u8*>(buffer), size);
+                if (this->m_dataSpan.data() != nullptr) {
+                    this->m_lastReadAddress = address;
+
+                    // Copy straight out of the attached memory. Anything outside of it reads as zeros
+                    const auto index = address - this->m_dataSpanAddress;
+                    if (index < this->m_dataSpan.size() && size <= this->m_dataSpan.size() - index)
+                        std::memcpy(buffer, this->m_dataSpan.data() + index, size);
+                    else
+                        std::memset(buffer, 0x00, size);
+                } else {
+                    this->m_readerFunction(address, static_cast<u8*>(buffer), size);
+                }
             } else {
                 if (address < this->m_dataBaseAddress + this->m_dataSize)
                     this->m_writerFunction(address, static_cast<u8*>(buffer), size);
@@ -804,6 +1129,9 @@ namespace pl::core {
             if (heapAddress < heap.size()) {
                 auto &storage = heap[heapAddress];
 
+                if (write || storageAddress + size > storage.size())
+                    this->journalHeapCell(heapAddress);
+
                 if (storageAddress + size > storage.size()) {
                     storage.resize(storageAddress + size);
                 }
@@ -903,8 +1231,10 @@ namespace pl::core {
     std::vector<u8>& Evaluator::getSection(u64 id) {
         if (id == ptrn::Pattern::MainSectionId)
             err::E0011.throwError("Cannot access main section.");
-        else if (id == ptrn::Pattern::HeapSectionId)
+        else if (id == ptrn::Pattern::HeapSectionId) {
+            this->journalHeapCell(this->m_heap.size() - 1);
             return this->m_heap.back();
+        }
         else if (this->m_sections.contains(id))
             return this->m_sections[id].data;
         else if (id == ptrn::Pattern::InstantiationSectionId)
@@ -929,6 +1259,13 @@ namespace pl::core {
     }
 
     bool Evaluator::evaluate(const std::vector<std::shared_ptr<ast::ASTNode>> &ast) {
+        return this->evaluate(ast, flattenStatements(ast));
+    }
+
+    bool Evaluator::evaluate(const std::vector<std::shared_ptr<ast::ASTNode>> &ast, const std::vector<ast::ASTNode*> &statements) {
+        // Lazy arrays of the last run can't create their entries anymore once its state is gone
+        this->m_evaluationId += 1;
+
         this->m_readOrderReversed = false;
         this->m_currBitOffset = 0;
 
@@ -939,20 +1276,30 @@ namespace pl::core {
         this->m_outVariableValues.clear();
 
         this->m_customFunctions.clear();
+        this->m_functionGeneration += 1;
         this->m_patterns.clear();
+        this->m_layoutTemplates.clear();
 
         this->m_scopes.clear();
         this->m_callStack.clear();
         this->m_heap.clear();
+        this->m_heapCheckpoints.clear();
 
         this->m_templateParameters.clear();
         this->m_currentTemplateArguments.clear();
         this->m_typeTemplateParameters.clear();
         this->m_attributedPatterns.clear();
+        this->m_constantAttributes.clear();
 
         this->m_patternLocalStorage.clear();
 
-        this->m_stringPool.clear();
+        // Give the memory of the last run back if none of its patterns are still being used. Names stay interned
+        // for as long as there are patterns left that refer to them by their id
+        if (this->m_patternArena.releaseIfUnused()) {
+            this->m_stringInterner.clear();
+            this->m_programNameIds.clear();
+        }
+        this->invalidateVariableLookups();
 
         this->m_mainResult.reset();
         this->m_aborted = false;
@@ -998,24 +1345,18 @@ namespace pl::core {
             this->pushScope(nullptr, this->m_patterns);
             this->pushTemplateParameters();
 
-            for (auto &topLevelNode : ast) {
-                std::vector<ast::ASTNode*> nodes;
-                if (auto compoundNode = dynamic_cast<ast::ASTNodeCompoundStatement*>(topLevelNode.get()))
-                    nodes = unpackCompoundStatements(compoundNode->getStatements());
-                else
-                    nodes.push_back(topLevelNode.get());
-
-                for (auto node : nodes) {
-                    if (node == nullptr)
-                        continue;
+            for (auto node : statements) {
+                auto startOffset = this->getBitwiseReadOffset();
 
-                    auto startOffset = this->getBitwiseReadOffset();
-
-                    if (dynamic_cast<ast::ASTNodeTypeDecl *>(node) != nullptr) {
+                switch (node->getKind()) {
+                    case ast::ASTNode::Kind::TypeDecl:
                         // Don't create patterns from type declarations
-                    } else if (dynamic_cast<ast::ASTNodeFunctionDefinition *>(node) != nullptr) {
+                        break;
+                    case ast::ASTNode::Kind::FunctionDefinition:
                         this->m_customFunctionDefinitions.push_back(node->evaluate(this));
-                    } else if (auto varDeclNode = dynamic_cast<ast::ASTNodeVariableDecl *>(node); varDeclNode != nullptr) {
+                        break;
+                    case ast::ASTNode::Kind::VariableDecl: {
+                        auto varDeclNode = static_cast<ast::ASTNodeVariableDecl *>(node);
                         bool localVariable = varDeclNode->getPlacementOffset() == nullptr;
 
                         if (localVariable)
@@ -1049,8 +1390,10 @@ namespace pl::core {
                         };
 
                         varDeclNode->createPatterns(this, patterns);
-
-                    } else if (auto arrayVarDeclNode = dynamic_cast<ast::ASTNodeArrayVariableDecl *>(node); arrayVarDeclNode != nullptr) {
+                        break;
+                    }
+                    case ast::ASTNode::Kind::ArrayVariableDecl: {
+                        auto arrayVarDeclNode = static_cast<ast::ASTNodeArrayVariableDecl *>(node);
                         bool localVariable = arrayVarDeclNode->getPlacementOffset() == nullptr;
 
                         if (localVariable)
@@ -1074,7 +1417,10 @@ namespace pl::core {
                         };
 
                         arrayVarDeclNode->createPatterns(this, patterns);
-                    } else if (auto pointerVarDecl = dynamic_cast<ast::ASTNodePointerVariableDecl *>(node); pointerVarDecl != nullptr) {
+                        break;
+                    }
+                    case ast::ASTNode::Kind::PointerVariableDecl: {
+                        auto pointerVarDecl = static_cast<ast::ASTNodePointerVariableDecl *>(node);
                         std::vector<std::shared_ptr<ptrn::Pattern>> patterns;
 
                         ON_SCOPE_EXIT {
@@ -1088,7 +1434,9 @@ namespace pl::core {
                         };
 
                         pointerVarDecl->createPatterns(this, patterns);
-                    } else if (auto controlFlowStatement = dynamic_cast<ast::ASTNodeControlFlowStatement *>(node); controlFlowStatement != nullptr) {
+                        break;
+                    }
+                    case ast::ASTNode::Kind::ControlFlowStatement: {
                         this->pushSectionId(ptrn::Pattern::HeapSectionId);
                         auto result = node->execute(this);
                         this->popSectionId();
@@ -1098,17 +1446,18 @@ namespace pl::core {
                         }
 
                         goto stop_evaluation;
-                    } else {
+                    }
+                    default:
                         this->pushSectionId(ptrn::Pattern::HeapSectionId);
                         wolv::util::unused(node->execute(this));
                         this->popSectionId();
-                    }
-
-                    if (this->getCurrentControlFlowStatement() == ControlFlowStatement::Return)
-                        goto stop_evaluation;
-                    else
-                        this->setCurrentControlFlowStatement(ControlFlowStatement::None);
+                        break;
                 }
+
+                if (this->getCurrentControlFlowStatement() == ControlFlowStatement::Return)
+                    goto stop_evaluation;
+                else
+                    this->setCurrentControlFlowStatement(ControlFlowStatement::None);
             }
 
             stop_evaluation:
@@ -0,0 +1,556 @@
+#include <pl/core/optimizer.hpp>
+
+#include <pl/core/bytecode.hpp>
+
+#include <pl/core/ast/ast_node.hpp>
+#include <pl/core/ast/ast_node_array_variable_decl.hpp>
+#include <pl/core/ast/ast_node_bitfield.hpp>
+#include <pl/core/ast/ast_node_bitfield_array_variable_decl.hpp>
+#include <pl/core/ast/ast_node_bitfield_field.hpp>
+#include <pl/core/ast/ast_node_builtin_type.hpp>
+#include <pl/core/ast/ast_node_cast.hpp>
+#include <pl/core/ast/ast_node_compound_statement.hpp>
+#include <pl/core/ast/ast_node_conditional_statement.hpp>
+#include <pl/core/ast/ast_node_control_flow_statement.hpp>
+#include <pl/core/ast/ast_node_enum.hpp>
+#include <pl/core/ast/ast_node_function_call.hpp>
+#include <pl/core/ast/ast_node_function_definition.hpp>
+#include <pl/core/ast/ast_node_literal.hpp>
+#include <pl/core/ast/ast_node_lvalue_assignment.hpp>
+#include <pl/core/ast/ast_node_match_statement.hpp>
+#include <pl/core/ast/ast_node_mathematical_expression.hpp>
+#include <pl/core/ast/ast_node_multi_variable_decl.hpp>
+#include <pl/core/ast/ast_node_pointer_variable_decl.hpp>
+#include <pl/core/ast/ast_node_rvalue.hpp>
+#include <pl/core/ast/ast_node_rvalue_assignment.hpp>
+#include <pl/core/ast/ast_node_struct.hpp>
+#include <pl/core/ast/ast_node_ternary_expression.hpp>
+#include <pl/core/ast/ast_node_try_catch_statement.hpp>
+#include <pl/core/ast/ast_node_type_appilication.hpp>
+#include <pl/core/ast/ast_node_type_decl.hpp>
+#include <pl/core/ast/ast_node_type_operator.hpp>
+#include <pl/core/ast/ast_node_union.hpp>
+#include <pl/core/ast/ast_node_variable_decl.hpp>
+#include <pl/core/ast/ast_node_while_statement.hpp>
+
+#include <wolv/utils/core.hpp>
+#include <wolv/utils/guards.hpp>
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <string_view>
+
+namespace pl::core {
+
+    namespace {
+
+        // Attributes that only change how a pattern is displayed but not how much data it covers
+        constexpr std::array LayoutNeutralAttributes = {
+            std::string_view("name"), std::string_view("comment"), std::string_view("color"), std::string_view("single_color"),
+            std::string_view("format"), std::string_view("format_read"), std::string_view("format_write"), std::string_view("format_entries"),
+            std::string_view("transform"), std::string_view("hidden"), std::string_view("highlight_hidden"), std::string_view("tree_hidden"),
+            std::string_view("inline"), std::string_view("sealed"), std::string_view("static"), std::string_view("export"), std::string_view("private"),
+            std::string_view("lazy"), std::string_view("compact")
+        };
+
+    }
+
+    void Optimizer::optimize(const std::vector<std::shared_ptr<ast::ASTNode>> &ast) {
+        this->m_typeDepth = 0;
+        this->m_visitedTypes.clear();
+        this->m_dynamicLayoutTypes.clear();
+        this->m_debugOutput.clear();
+        this->m_warnings.clear();
+        this->m_statistics = { };
+
+        this->optimizeNodes(ast);
+    }
+
+    void Optimizer::optimizeNodes(const std::vector<std::shared_ptr<ast::ASTNode>> &nodes) {
+        for (const auto &node : nodes)
+            this->optimizeNode(node.get());
+    }
+
+    void Optimizer::optimizeNodes(const std::vector<std::unique_ptr<ast::ASTNode>> &nodes) {
+        for (const auto &node : nodes)
+            this->optimizeNode(node.get());
+    }
+
+    void Optimizer::optimizeNode(ast::ASTNode *node) {
+        using namespace ast;
+
+        if (node == nullptr)
+            return;
+
+        if (auto typeDecl = dynamic_cast<ASTNodeTypeDecl *>(node); typeDecl != nullptr) {
+            // Types are shared between all places that use them
+            if (!this->m_visitedTypes.insert(typeDecl).second)
+                return;
+
+            if (typeDecl->isValid()) {
+                this->optimizeNode(typeDecl->getType().get());
+                if (this->analyzeLayout(typeDecl) == nullptr)
+                    this->checkStaticHint(typeDecl);
+            }
+        } else if (auto typeApplication = dynamic_cast<ASTNodeTypeApplication *>(node); typeApplication != nullptr) {
+            this->optimizeNodes(typeApplication->getTemplateArguments());
+            this->optimizeNode(typeApplication->getType().get());
+        } else if (auto compoundStatement = dynamic_cast<ASTNodeCompoundStatement *>(node); compoundStatement != nullptr) {
+            this->optimizeNodes(compoundStatement->getStatements());
+        } else if (auto functionDefinition = dynamic_cast<ASTNodeFunctionDefinition *>(node); functionDefinition != nullptr) {
+            for (const auto &[name, type] : functionDefinition->getParams())
+                this->optimizeNode(type.get());
+
+            this->optimizeNodes(functionDefinition->getDefaultParameters());
+            this->optimizeNodes(functionDefinition->getBody());
+        } else if (auto structNode = dynamic_cast<ASTNodeStruct *>(node); structNode != nullptr) {
+            this->optimizeNodes(structNode->getInheritance());
+            this->optimizeNodes(structNode->getMembers());
+        } else if (auto unionNode = dynamic_cast<ASTNodeUnion *>(node); unionNode != nullptr) {
+            this->optimizeNodes(unionNode->getMembers());
+        } else if (auto bitfield = dynamic_cast<ASTNodeBitfield *>(node); bitfield != nullptr) {
+            this->optimizeNodes(bitfield->getEntries());
+        } else if (auto bitfieldField = dynamic_cast<ASTNodeBitfieldField *>(node); bitfieldField != nullptr) {
+            this->optimizeNode(bitfieldField->getSize().get());
+        } else if (auto enumNode = dynamic_cast<ASTNodeEnum *>(node); enumNode != nullptr) {
+            for (const auto &[name, values] : enumNode->getEntries()) {
+                this->optimizeNode(values.first.get());
+                this->optimizeNode(values.second.get());
+            }
+        } else if (auto variableDecl = dynamic_cast<ASTNodeVariableDecl *>(node); variableDecl != nullptr) {
+            this->optimizeNode(variableDecl->getType().get());
+            this->optimizeNode(variableDecl->getPlacementOffset().get());
+        } else if (auto arrayVariableDecl = dynamic_cast<ASTNodeArrayVariableDecl *>(node); arrayVariableDecl != nullptr) {
+            this->optimizeNode(arrayVariableDecl->getType().get());
+            this->optimizeNode(arrayVariableDecl->getSize().get());
+            this->optimizeNode(arrayVariableDecl->getPlacementOffset().get());
+        } else if (auto pointerVariableDecl = dynamic_cast<ASTNodePointerVariableDecl *>(node); pointerVariableDecl != nullptr) {
+            this->optimizeNode(pointerVariableDecl->getType().get());
+            this->optimizeNode(pointerVariableDecl->getSizeType().get());
+            this->optimizeNode(pointerVariableDecl->getPlacementOffset().get());
+        } else if (auto multiVariableDecl = dynamic_cast<ASTNodeMultiVariableDecl *>(node); multiVariableDecl != nullptr) {
+            this->optimizeNodes(multiVariableDecl->getVariables());
+        } else if (auto conditionalStatement = dynamic_cast<ASTNodeConditionalStatement *>(node); conditionalStatement != nullptr) {
+            this->optimizeNode(conditionalStatement->getCondition().get());
+            this->pruneConditional(conditionalStatement);
+
+            // The body that can never run stays in the tree as written
+            const auto constantCondition = conditionalStatement->getConstantCondition();
+            if (constantCondition.value_or(true))
+                this->optimizeNodes(conditionalStatement->getTrueBody());
+            if (!constantCondition.value_or(false))
+                this->optimizeNodes(conditionalStatement->getFalseBody());
+        } else if (auto whileStatement = dynamic_cast<ASTNodeWhileStatement *>(node); whileStatement != nullptr) {
+            this->optimizeNode(whileStatement->getCondition().get());
+            this->optimizeNodes(whileStatement->getBody());
+        } else if (auto tryCatchStatement = dynamic_cast<ASTNodeTryCatchStatement *>(node); tryCatchStatement != nullptr) {
+            this->optimizeNodes(tryCatchStatement->getTryBody());
+            this->optimizeNodes(tryCatchStatement->getCatchBody());
+        } else if (auto matchStatement = dynamic_cast<ASTNodeMatchStatement *>(node); matchStatement != nullptr) {
+            for (const auto &matchCase : matchStatement->getCases()) {
+                this->optimizeNode(matchCase.condition.get());
+                this->optimizeNodes(matchCase.body);
+            }
+
+            if (const auto &defaultCase = matchStatement->getDefaultCase(); defaultCase.has_value())
+                this->optimizeNodes(defaultCase->body);
+        } else if (auto controlFlowStatement = dynamic_cast<ASTNodeControlFlowStatement *>(node); controlFlowStatement != nullptr) {
+            this->optimizeNode(controlFlowStatement->getRValue().get());
+        } else if (auto lvalueAssignment = dynamic_cast<ASTNodeLValueAssignment *>(node); lvalueAssignment != nullptr) {
+            this->optimizeNode(lvalueAssignment->getRValue().get());
+        } else if (auto rvalueAssignment = dynamic_cast<ASTNodeRValueAssignment *>(node); rvalueAssignment != nullptr) {
+            this->optimizeNode(rvalueAssignment->getLValue().get());
+            this->optimizeNode(rvalueAssignment->getRValue().get());
+        } else if (auto functionCall = dynamic_cast<ASTNodeFunctionCall *>(node); functionCall != nullptr) {
+            this->optimizeNodes(functionCall->getParams());
+        } else if (auto cast = dynamic_cast<ASTNodeCast *>(node); cast != nullptr) {
+            this->optimizeNode(cast->getValue().get());
+        } else if (auto rvalue = dynamic_cast<ASTNodeRValue *>(node); rvalue != nullptr) {
+            for (const auto &segment : rvalue->getPath()) {
+                if (auto index = std::get_if<std::unique_ptr<ASTNode>>(&segment); index != nullptr)
+                    this->optimizeNode(index->get());
+            }
+        } else if (auto typeOperator = dynamic_cast<ASTNodeTypeOperator *>(node); typeOperator != nullptr) {
+            this->optimizeNode(typeOperator->getExpression().get());
+            this->computeStaticSize(typeOperator);
+        } else if (auto mathematicalExpression = dynamic_cast<ASTNodeMathematicalExpression *>(node); mathematicalExpression != nullptr) {
+            this->optimizeNode(mathematicalExpression->getLeftOperand().get());
+            this->optimizeNode(mathematicalExpression->getRightOperand().get());
+            this->foldExpression(mathematicalExpression);
+        } else if (auto ternaryExpression = dynamic_cast<ASTNodeTernaryExpression *>(node); ternaryExpression != nullptr) {
+            this->optimizeNode(ternaryExpression->getFirstOperand().get());
+            this->optimizeNode(ternaryExpression->getSecondOperand().get());
+            this->optimizeNode(ternaryExpression->getThirdOperand().get());
+            this->foldExpression(ternaryExpression);
+        }
+    }
+
+    void Optimizer::foldExpression(ast::ASTNode *node) {
+        if (getConstantValue(node).has_value())
+            return;
+
+        // Operands have been folded already so only expressions made up entirely of constants compile to programs without loads
+        const auto program = bytecode::Program::compile(node);
+        if (program == nullptr || !program->isConstant())
+            return;
+
+        // Division by zero and the like are left to the evaluator so they're reported when the expression is reached
+        auto value = program->execute(nullptr);
+        if (!value.has_value())
+            return;
+
+        this->addDebugOutput(node, fmt::format("Folded expression to {}", value->toString(true)));
+
+        if (auto expression = dynamic_cast<ast::ASTNodeMathematicalExpression *>(node); expression != nullptr)
+            expression->setConstantValue(std::move(*value));
+        else if (auto ternary = dynamic_cast<ast::ASTNodeTernaryExpression *>(node); ternary != nullptr)
+            ternary->setConstantValue(std::move(*value));
+
+        this->m_statistics.foldedExpressions += 1;
+    }
+
+    void Optimizer::pruneConditional(ast::ASTNode *node) {
+        auto conditionalStatement = dynamic_cast<ast::ASTNodeConditionalStatement *>(node);
+        if (conditionalStatement == nullptr || conditionalStatement->getConstantCondition().has_value())
+            return;
+
+        const auto value = getConstantValue(conditionalStatement->getCondition().get());
+        if (!value.has_value())
+            return;
+
+        // Same conversion as ASTNodeConditionalStatement::evaluateCondition()
+        const auto condition = std::visit(wolv::util::overloaded {
+            [](const std::string &) -> std::optional<bool> { return std::nullopt; },
+            [](const std::shared_ptr<ptrn::Pattern> &) -> std::optional<bool> { return std::nullopt; },
+            [](auto &&value) -> std::optional<bool> { return value != 0; }
+        }, *value);
+
+        if (!condition.has_value())
+            return;
+
+        this->addDebugOutput(node, fmt::format("Condition is always {}, skipping {} branch", *condition, *condition ? "false" : "true"));
+
+        conditionalStatement->setConstantCondition(*condition);
+        this->m_statistics.prunedBranches += 1;
+    }
+
+    void Optimizer::computeStaticSize(ast::ASTNode *node) {
+        auto typeOperator = dynamic_cast<ast::ASTNodeTypeOperator *>(node);
+        if (typeOperator == nullptr || typeOperator->getOperator() != Token::Operator::SizeOf || typeOperator->getConstantValue().has_value())
+            return;
+
+        // Only types have a size that's known upfront, variables and $ depend on the data
+        auto typeApplication = dynamic_cast<ast::ASTNodeTypeApplication *>(typeOperator->getExpression().get());
+        if (typeApplication == nullptr)
+            return;
+
+        const auto size = this->getStaticSize(typeApplication);
+        if (!size.has_value())
+            return;
+
+        this->addDebugOutput(node, fmt::format("sizeof({}) is {}", typeApplication->getTypeName(), *size));
+
+        typeOperator->setConstantValue(u128(*size));
+        this->m_statistics.staticSizes += 1;
+    }
+
+    void Optimizer::checkStaticHint(const ast::ASTNodeTypeDecl *typeDecl) {
+        // Template types are only checked once they're instantiated
+        if (typeDecl->isTemplateType())
+            return;
+
+        auto type = dynamic_cast<const ast::Attributable *>(typeDecl->getType().get());
+        if (!typeDecl->hasAttribute("static", false) && (type == nullptr || !type->hasAttribute("static", false)))
+            return;
+
+        // Types can have a layout the optimizer can't compute without it depending on the data, only warn about the ones that really do
+        const auto dependency = this->findDataDependency(typeDecl->getType().get());
+        if (!dependency.has_value())
+            return;
+
+        this->addWarning(dependency->node, fmt::format("Type '{}' is marked as [[static]] but {} depends on the data. Arrays of it will reuse the first entry's layout for all entries", typeDecl->getName(), dependency->description));
+    }
+
+    std::optional<Optimizer::DataDependency> Optimizer::findDataDependency(ast::ASTNode *node) {
+        using namespace ast;
+
+        if (node == nullptr || this->m_typeDepth >= MaxTypeDepth)
+            return std::nullopt;
+
+        this->m_typeDepth += 1;
+        ON_SCOPE_EXIT { this->m_typeDepth -= 1; };
+
+        const auto findInNodes = [this](const auto &nodes) -> std::optional<DataDependency> {
+            for (const auto &child : nodes) {
+                if (auto dependency = this->findDataDependency(child.get()); dependency.has_value())
+                    return dependency;
+            }
+
+            return std::nullopt;
+        };
+
+        if (auto typeApplication = dynamic_cast<ASTNodeTypeApplication *>(node); typeApplication != nullptr) {
+            return this->findDataDependency(typeApplication->getType().get());
+        } else if (auto typeDecl = dynamic_cast<ASTNodeTypeDecl *>(node); typeDecl != nullptr) {
+            if (!typeDecl->isValid())
+                return std::nullopt;
+
+            // Types can be referenced before the optimizer reached them, make sure their expressions have been folded already
+            this->optimizeNode(typeDecl);
+
+            return this->findDataDependency(typeDecl->getType().get());
+        } else if (auto structNode = dynamic_cast<ASTNodeStruct *>(node); structNode != nullptr) {
+            if (auto dependency = findInNodes(structNode->getInheritance()); dependency.has_value())
+                return dependency;
+
+            return findInNodes(structNode->getMembers());
+        } else if (auto unionNode = dynamic_cast<ASTNodeUnion *>(node); unionNode != nullptr) {
+            return findInNodes(unionNode->getMembers());
+        } else if (auto bitfield = dynamic_cast<ASTNodeBitfield *>(node); bitfield != nullptr) {
+            return findInNodes(bitfield->getEntries());
+        } else if (auto bitfieldField = dynamic_cast<ASTNodeBitfieldField *>(node); bitfieldField != nullptr) {
+            if (!getConstantValue(bitfieldField->getSize().get()).has_value())
+                return DataDependency { node, fmt::format("the size of field '{}'", bitfieldField->getName()) };
+
+            return std::nullopt;
+        } else if (auto bitfieldArray = dynamic_cast<ASTNodeBitfieldArrayVariableDecl *>(node); bitfieldArray != nullptr) {
+            if (!getConstantValue(bitfieldArray->getSize().get()).has_value())
+                return DataDependency { node, fmt::format("the size of array '{}'", bitfieldArray->getName()) };
+
+            return this->findDataDependency(bitfieldArray->getType().get());
+        } else if (auto variableDecl = dynamic_cast<ASTNodeVariableDecl *>(node); variableDecl != nullptr) {
+            if (variableDecl->getPlacementOffset() != nullptr && !getConstantValue(variableDecl->getPlacementOffset().get()).has_value())
+                return DataDependency { node, fmt::format("the placement of '{}'", variableDecl->getName()) };
+
+            return this->findDataDependency(variableDecl->getType().get());
+        } else if (auto arrayVariableDecl = dynamic_cast<ASTNodeArrayVariableDecl *>(node); arrayVariableDecl != nullptr) {
+            if (arrayVariableDecl->getSize() == nullptr || !getConstantValue(arrayVariableDecl->getSize().get()).has_value())
+                return DataDependency { node, fmt::format("the size of array '{}'", arrayVariableDecl->getName()) };
+            if (arrayVariableDecl->getPlacementOffset() != nullptr && !getConstantValue(arrayVariableDecl->getPlacementOffset().get()).has_value())
+                return DataDependency { node, fmt::format("the placement of '{}'", arrayVariableDecl->getName()) };
+
+            return this->findDataDependency(arrayVariableDecl->getType().get());
+        } else if (auto multiVariableDecl = dynamic_cast<ASTNodeMultiVariableDecl *>(node); multiVariableDecl != nullptr) {
+            return findInNodes(multiVariableDecl->getVariables());
+        } else if (auto conditionalStatement = dynamic_cast<ASTNodeConditionalStatement *>(node); conditionalStatement != nullptr) {
+            // Conditions that were folded always pick the same branch
+            if (const auto condition = conditionalStatement->getConstantCondition(); condition.has_value())
+                return findInNodes(*condition ? conditionalStatement->getTrueBody() : conditionalStatement->getFalseBody());
+
+            return DataDependency { node, "the conditional" };
+        } else if (dynamic_cast<ASTNodeMatchStatement *>(node) != nullptr) {
+            return DataDependency { node, "the match statement" };
+        } else if (auto compoundStatement = dynamic_cast<ASTNodeCompoundStatement *>(node); compoundStatement != nullptr) {
+            return findInNodes(compoundStatement->getStatements());
+        } else {
+            return std::nullopt;
+        }
+    }
+
+    std::optional<Token::Literal> Optimizer::getConstantValue(const ast::ASTNode *node) {
+        if (auto literal = dynamic_cast<const ast::ASTNodeLiteral *>(node); literal != nullptr)
+            return literal->getValue();
+        else if (auto expression = dynamic_cast<const ast::ASTNodeMathematicalExpression *>(node); expression != nullptr)
+            return expression->getConstantValue();
+        else if (auto ternary = dynamic_cast<const ast::ASTNodeTernaryExpression *>(node); ternary != nullptr)
+            return ternary->getConstantValue();
+        else if (auto typeOperator = dynamic_cast<const ast::ASTNodeTypeOperator *>(node); typeOperator != nullptr)
+            return typeOperator->getConstantValue();
+        else
+            return std::nullopt;
+    }
+
+    bool Optimizer::hasStaticAttributes(const ast::Attributable &attributable) {
+        return std::ranges::all_of(attributable.getAttributes(), [](const auto &attribute) {
+            if (std::ranges::find(LayoutNeutralAttributes, attribute->getAttribute()) == LayoutNeutralAttributes.end())
+                return false;
+
+            // Arguments get evaluated for every instance so only constant ones are guaranteed to give the same result every time
+            return std::ranges::all_of(attribute->getArguments(), [](const auto &argument) {
+                return getConstantValue(argument.get()).has_value();
+            });
+        });
+    }
+
+    const ast::StaticLayout* Optimizer::analyzeLayout(ast::ASTNodeTypeDecl *typeDecl) {
+        using namespace ast;
+
+        // Types can be referenced before the optimizer reached them, make sure their expressions have been folded already
+        this->optimizeNode(typeDecl);
+
+        if (const auto &layout = typeDecl->getStaticLayout(); layout.has_value())
+            return &*layout;
+        if (this->m_dynamicLayoutTypes.contains(typeDecl))
+            return nullptr;
+
+        std::optional<StaticLayout> layout;
+        if (typeDecl->isValid() && !typeDecl->isTemplateType() && hasStaticAttributes(*typeDecl)) {
+            if (auto structNode = dynamic_cast<ASTNodeStruct *>(typeDecl->getType().get()); structNode != nullptr) {
+                if (structNode->getInheritance().empty() && hasStaticAttributes(*structNode)) {
+                    layout = StaticLayout();
+                    for (const auto &member : structNode->getMembers()) {
+                        if (!this->addStaticMember(member.get(), *layout)) {
+                            layout.reset();
+                            break;
+                        }
+                    }
+                }
+            } else if (const auto size = this->getStaticSize(typeDecl->getType().get()); size.has_value()) {
+                layout = StaticLayout { *size, { } };
+            }
+        }
+
+        if (!layout.has_value()) {
+            this->m_dynamicLayoutTypes.insert(typeDecl);
+            return nullptr;
+        }
+
+        this->addDebugOutput(typeDecl, fmt::format("Type '{}' has a static layout of {} bytes", typeDecl->getName(), layout->size));
+
+        typeDecl->setStaticLayout(std::move(*layout));
+        this->m_statistics.staticLayouts += 1;
+
+        return &*typeDecl->getStaticLayout();
+    }
+
+    std::optional<u64> Optimizer::getStaticSize(ast::ASTNode *type) {
+        using namespace ast;
+
+        if (type == nullptr || this->m_typeDepth >= MaxTypeDepth)
+            return std::nullopt;
+
+        this->m_typeDepth += 1;
+        ON_SCOPE_EXIT { this->m_typeDepth -= 1; };
+
+        if (auto typeApplication = dynamic_cast<ASTNodeTypeApplication *>(type); typeApplication != nullptr) {
+            if (!typeApplication->getTemplateArguments().empty() || typeApplication->isReference())
+                return std::nullopt;
+
+            return this->getStaticSize(typeApplication->getType().get());
+        } else if (auto typeDecl = dynamic_cast<ASTNodeTypeDecl *>(type); typeDecl != nullptr) {
+            const auto layout = this->analyzeLayout(typeDecl);
+            if (layout == nullptr)
+                return std::nullopt;
+
+            return layout->size;
+        } else if (auto builtinType = dynamic_cast<ASTNodeBuiltinType *>(type); builtinType != nullptr) {
+            // Strings have no fixed size and the size of custom types is only known once they're created
+            const auto valueType = builtinType->getType();
+            if (valueType == Token::ValueType::String || valueType == Token::ValueType::Auto || valueType == Token::ValueType::CustomType)
+                return std::nullopt;
+
+            return Token::getTypeSize(valueType);
+        } else if (auto enumNode = dynamic_cast<ASTNodeEnum *>(type); enumNode != nullptr) {
+            if (!hasStaticAttributes(*enumNode))
+                return std::nullopt;
+
+            return this->getStaticSize(enumNode->getUnderlyingType().get());
+        } else if (auto bitfield = dynamic_cast<ASTNodeBitfield *>(type); bitfield != nullptr) {
+            if (!hasStaticAttributes(*bitfield))
+                return std::nullopt;
+
+            u64 bitCount = 0;
+            for (const auto &entry : bitfield->getEntries()) {
+                // Fields with a type, nested bitfields and conditionals create patterns whose size depends on the data
+                auto field = dynamic_cast<ASTNodeBitfieldField *>(entry.get());
+                if (field == nullptr || dynamic_cast<ASTNodeBitfieldFieldSizedType *>(field) != nullptr || !hasStaticAttributes(*field))
+                    return std::nullopt;
+
+                const auto fieldSize = getConstantValue(field->getSize().get());
+                if (!fieldSize.has_value())
+                    return std::nullopt;
+
+                // Same conversion as ASTNodeBitfieldField::createPatterns()
+                const auto bitSize = std::visit(wolv::util::overloaded {
+                    [](const std::string &) -> std::optional<u8> { return std::nullopt; },
+                    [](const std::shared_ptr<ptrn::Pattern> &) -> std::optional<u8> { return std::nullopt; },
+                    [](auto &&value) -> std::optional<u8> { return static_cast<u8>(value); }
+                }, *fieldSize);
+                if (!bitSize.has_value())
+                    return std::nullopt;
+
+                bitCount += *bitSize;
+            }
+
+            // Bitfields that don't end on a byte boundary shift everything that follows them
+            if (bitCount % 8 != 0)
+                return std::nullopt;
+
+            return bitCount / 8;
+        } else {
+            return std::nullopt;
+        }
+    }
+
+    bool Optimizer::addStaticMember(ast::ASTNode *member, ast::StaticLayout &layout) {
+        using namespace ast;
+
+        std::string name;
+        u128 size = 0;
+        if (auto variableDecl = dynamic_cast<ASTNodeVariableDecl *>(member); variableDecl != nullptr) {
+            if (variableDecl->getPlacementOffset() != nullptr || variableDecl->isConstant() || !hasStaticAttributes(*variableDecl))
+                return false;
+
+            const auto typeSize = this->getStaticSize(variableDecl->getType().get());
+            if (!typeSize.has_value())
+                return false;
+
+            name = variableDecl->getName();
+            size = *typeSize;
+        } else if (auto arrayVariableDecl = dynamic_cast<ASTNodeArrayVariableDecl *>(member); arrayVariableDecl != nullptr) {
+            if (arrayVariableDecl->getPlacementOffset() != nullptr || arrayVariableDecl->isConstant() || !hasStaticAttributes(*arrayVariableDecl))
+                return false;
+
+            // Unsized arrays and arrays with a loop condition as size depend on the data
+            const auto count = getConstantValue(arrayVariableDecl->getSize().get());
+            if (!count.has_value())
+                return false;
+
+            const auto entryCount = std::visit(wolv::util::overloaded {
+                [](u128 value) -> std::optional<u128> { return value; },
+                [](i128 value) -> std::optional<u128> { return value < 0 ? std::nullopt : std::optional<u128>(value); },
+                [](const auto &) -> std::optional<u128> { return std::nullopt; }
+            }, *count);
+            if (!entryCount.has_value() || *entryCount > std::numeric_limits<u64>::max())
+                return false;
+
+            const auto entrySize = this->getStaticSize(arrayVariableDecl->getType().get());
+            if (!entrySize.has_value())
+                return false;
+
+            name = arrayVariableDecl->getName();
+            size = u128(*entrySize) * *entryCount;
+        } else if (auto multiVariableDecl = dynamic_cast<ASTNodeMultiVariableDecl *>(member); multiVariableDecl != nullptr) {
+            return std::ranges::all_of(multiVariableDecl->getVariables(), [&](const auto &variable) {
+                return this->addStaticMember(variable.get(), layout);
+            });
+        } else {
+            return false;
+        }
+
+        if (size > std::numeric_limits<u64>::max() - layout.size)
+            return false;
+
+        layout.members.push_back({ std::move(name), layout.size, u64(size) });
+        layout.size += u64(size);
+
+        return true;
+    }
+
+    void Optimizer::addDebugOutput(const ast::ASTNode *node, const std::string &message) {
+        if (!this->m_debugOutputEnabled)
+            return;
+
+        const auto &location = node->getLocation();
+        this->m_debugOutput.push_back(fmt::format("Optimizer: {}:{}: {}", location.line, location.column, message));
+    }
+
+    void Optimizer::addWarning(const ast::ASTNode *node, const std::string &message) {
+        const auto &location = node->getLocation();
+        this->m_warnings.push_back(fmt::format("{}:{}: {}", location.line, location.column, message));
+    }
+
+}
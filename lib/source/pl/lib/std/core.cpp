@@ -30,7 +30,7 @@ namespace pl::lib::libstd::core {
                 auto pattern = params[0].toPattern();
                 auto attributeName = params[1].toString(false);
 
-                auto &attributes = pattern->getAttributes();
+                const auto attributes = pattern->getAttributes();
                 if (attributes == nullptr)
                     return false;
                 else
@@ -43,7 +43,7 @@ namespace pl::lib::libstd::core {
                 auto attributeName = params[1].toString(false);
                 auto index = size_t(params[2].toUnsigned());
 
-                auto &attributes = pattern->getAttributes();
+                const auto attributes = pattern->getAttributes();
                 if (attributes == nullptr || !attributes->contains(attributeName))
                     return std::string();
                 else {
@@ -127,14 +127,14 @@ namespace pl::lib::libstd::core {
             });
 
             /* has_member(pattern, name) -> member_exists */
-            runtime.addFunction(nsStdCore, "has_member", FunctionParameterCount::exactly(2), [](Evaluator *, auto params) -> std::optional<Token::Literal> {
+            runtime.addFunction(nsStdCore, "has_member", FunctionParameterCount::exactly(2), [](Evaluator *evaluator, auto params) -> std::optional<Token::Literal> {
                 auto pattern = params[0].toPattern();
-                auto name = params[1].toString(false);
+                auto nameId = evaluator->getStringInterner().intern(params[1].toString(false));
 
                 auto hasMember = [&](const auto &members) {
                     return std::any_of(members.begin(), members.end(),
                         [&](const std::shared_ptr<ptrn::Pattern> &member) {
-                            return member->getVariableName() == name;
+                            return evaluator->getVariableNameId(*member) == nameId;
                         });
                 };
 
@@ -155,7 +155,7 @@ namespace pl::lib::libstd::core {
             runtime.addFunction(nsStdCore, "is_valid_enum", FunctionParameterCount::exactly(1), [](Evaluator *, auto params) -> std::optional<Token::Literal> {
                 auto pattern = params[0].toPattern();
 
-                if (auto enumPattern = dynamic_cast<ptrn::PatternEnum*>(pattern.get()); enumPattern != nullptr) {
+                if (auto enumPattern = ptrn::pattern_cast<ptrn::PatternEnum>(pattern.get()); enumPattern != nullptr) {
                     auto value = enumPattern->getValue().toUnsigned();
                     for (auto &[name, entry] : enumPattern->getEnumValues()) {
                         auto min = entry.min.toUnsigned();
@@ -196,7 +196,7 @@ namespace pl::lib::libstd::core {
                     // Check for duplicates
                     for (auto &a : entries) {
                         for (auto &b : currScope) {
-                            if (a->getVariableName() == b->getVariableName()) [[unlikely]] {
+                            if (a->hasSameVariableName(*b)) [[unlikely]] {
                                 err::E0012.throwError(fmt::format("Error inserting patterns into current scope. Pattern with name '{}' already exists.", a->getVariableName()));
                             }
                         }
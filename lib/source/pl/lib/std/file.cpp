@@ -19,8 +19,9 @@ namespace pl::lib::libstd::file {
 
         api::Namespace nsStdFile = { "builtin", "std", "file" };
         {
-            static u32 fileCounter = 0;
-            static std::map<u32, wolv::io::File> openFiles;
+            // Open files are tracked per thread so runtimes running in parallel don't close each other's files on cleanup
+            thread_local u32 fileCounter = 0;
+            thread_local std::map<u32, wolv::io::File> openFiles;
 
             runtime.addCleanupCallback([](pl::PatternLanguage&) {
                 for (auto &[id, file] : openFiles)
@@ -57,6 +57,16 @@ namespace pl::lib::libstd {
             return true;
         });
 
+        // Limits the number of entries, not bytes, each [[lazy]] or [[compact]] array keeps created at the same time
+        runtime.addPragma("lazy_entry_limit", [](pl::PatternLanguage &runtime, const std::string &value) {
+            auto limit = parseLimit(value);
+            if (!limit.has_value())
+                return false;
+
+            runtime.getInternals().evaluator->setLazyEntryLimit(*limit);
+            return true;
+        });
+
         runtime.addPragma("pattern_limit", [](pl::PatternLanguage &runtime, const std::string &value) {
             auto limit = parseLimit(value);
             if (!limit.has_value())
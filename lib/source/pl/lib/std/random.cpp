@@ -28,8 +28,8 @@ namespace pl::lib::libstd::random {
         Poisson = 15
     };
 
-    static std::random_device randomDevice;
-    static std::mt19937_64 random(randomDevice());
+    // Every thread gets its own engine so runtimes executing on different threads don't race on it
+    static thread_local std::mt19937_64 random(std::random_device{}());
 
     template<typename T>
     constexpr static auto generateNumber(auto && ... params) {
@@ -4,6 +4,7 @@
 #include <pl/core/lexer.hpp>
 #include <pl/core/parser.hpp>
 #include <pl/core/validator.hpp>
+#include <pl/core/optimizer.hpp>
 #include <pl/core/evaluator.hpp>
 #include <pl/core/errors/error.hpp>
 #include <pl/core/resolver.hpp>
@@ -11,6 +12,7 @@
 
 #include <pl/patterns/pattern.hpp>
 #include <pl/patterns/pattern_array_static.hpp>
+#include <pl/patterns/pattern_array_dynamic.hpp>
 
 #include <pl/lib/std/libstd.hpp>
 
@@ -18,6 +20,9 @@
 #include <wolv/io/file.hpp>
 #include <wolv/utils/string.hpp>
 
+#include <cstring>
+#include <future>
+
 namespace pl {
 
     static std::string getFunctionName(const api::Namespace &ns, const std::string &name) {
@@ -32,12 +37,58 @@ namespace pl {
         return functionName;
     }
 
+    static void releaseTypes(const std::map<std::string, hlp::safe_shared_ptr<core::ast::ASTNodeTypeDecl>> &types) {
+        for (const auto &[_, type] : types) {
+            if (type == nullptr || !type->isValid())
+                continue;
+
+            if (auto builtinType = dynamic_cast<core::ast::ASTNodeBuiltinType*>(type->getType().get()); builtinType != nullptr) {
+                if (builtinType->getType() != core::Token::ValueType::CustomType)
+                    type->setType(nullptr);
+            } else {
+                type->setType(nullptr);
+            }
+        }
+    }
+
+    struct CompiledPattern::Data {
+        ~Data() {
+            // Types reference each other, break up these cycles the same way resetting the parser does
+            for (const auto &typeMap : this->types)
+                releaseTypes(typeMap);
+        }
+
+        std::string source;
+        std::vector<std::shared_ptr<core::ast::ASTNode>> ast;
+        std::vector<core::ast::ASTNode*> statements;
+        std::vector<std::map<std::string, hlp::safe_shared_ptr<core::ast::ASTNodeTypeDecl>>> types;
+        std::vector<std::pair<std::string, std::string>> pragmas;
+        std::vector<PatternLanguage::Function> functions;
+    };
+
+    const std::vector<std::shared_ptr<core::ast::ASTNode>>& CompiledPattern::getAST() const {
+        static const std::vector<std::shared_ptr<core::ast::ASTNode>> empty;
+        if (this->m_data == nullptr)
+            return empty;
+
+        return this->m_data->ast;
+    }
+
+    const std::string& CompiledPattern::getSource() const {
+        static const std::string empty;
+        if (this->m_data == nullptr)
+            return empty;
+
+        return this->m_data->source;
+    }
+
     PatternLanguage::PatternLanguage(const bool addLibStd) {
         this->m_internals = {
             .preprocessor   = std::make_unique<core::Preprocessor>(),
             .lexer          = std::make_unique<core::Lexer>(),
             .parser         = std::make_unique<core::Parser>(),
             .validator      = std::make_unique<core::Validator>(),
+            .optimizer      = std::make_unique<core::Optimizer>(),
             .evaluator      = std::make_unique<core::Evaluator>()
         };
 
@@ -57,12 +108,14 @@ namespace pl {
             this->m_internals.parser->reset();
         this->m_patterns.clear();
         this->m_flattenedPatterns.clear();
+        this->m_stridedHighlights.clear();
         this->m_flattenedPatternsValid = false;
     }
 
     PatternLanguage::PatternLanguage(PatternLanguage &&other) noexcept {
-        if (this->m_flattenThread.joinable())
-            this->m_flattenThread.join();
+        // The flattening thread refers to the other runtime, let it finish before taking over its patterns
+        if (other.m_flattenThread.joinable())
+            other.m_flattenThread.join();
 
         this->m_internals           = std::move(other.m_internals);
         other.m_internals = { };
@@ -81,13 +134,18 @@ namespace pl {
 
         this->m_patterns            = std::move(other.m_patterns);
         this->m_flattenedPatterns   = std::move(other.m_flattenedPatterns);
+        this->m_stridedHighlights   = std::move(other.m_stridedHighlights);
+        this->m_flattenedPatternsValid.exchange(other.m_flattenedPatternsValid.load());
         this->m_cleanupCallbacks    = std::move(other.m_cleanupCallbacks);
         this->m_currAST             = std::move(other.m_currAST);
+        this->m_currStatements      = std::move(other.m_currStatements);
 
         this->m_dataBaseAddress     = other.m_dataBaseAddress;
         this->m_dataSize            = other.m_dataSize;
         this->m_dataReadFunction    = std::move(other.m_dataReadFunction);
         this->m_dataWriteFunction   = std::move(other.m_dataWriteFunction);
+        this->m_dataSpan            = other.m_dataSpan;
+        this->m_dataCache           = std::move(other.m_dataCache);
 
         this->m_logCallback                     = std::move(other.m_logCallback);
         this->m_dangerousFunctionCallCallback   = std::move(other.m_dangerousFunctionCallCallback);
@@ -121,6 +179,8 @@ namespace pl {
         runtime.m_dataSize            = this->m_dataSize;
         runtime.m_dataReadFunction    = this->m_dataReadFunction;
         runtime.m_dataWriteFunction   = this->m_dataWriteFunction;
+        runtime.m_dataSpan            = this->m_dataSpan;
+        runtime.m_dataCache.configure(this->m_dataCache.getPageSize(), this->m_dataCache.getPageCount());
 
         runtime.m_logCallback                     = this->m_logCallback;
         runtime.m_dangerousFunctionCallCallback   = this->m_dangerousFunctionCallCallback;
@@ -181,6 +241,21 @@ namespace pl {
             validatorErrors.clear();
         }
 
+        // Only optimize trees that are going to be evaluated, broken code is reported as written
+        if (this->m_compileErrors.empty()) {
+            const auto &evaluator = this->m_internals.evaluator;
+
+            // compile() parses without going through executeImpl(), so make sure the messages reach the log callback there as well
+            evaluator->getConsole().setLogCallback(this->m_logCallback);
+
+            this->m_internals.optimizer->setDebugOutputEnabled(evaluator->isDebugModeEnabled());
+            this->m_internals.optimizer->optimize(ast.value());
+
+            for (const auto &line : this->m_internals.optimizer->getDebugOutput())
+                evaluator->getConsole().log(core::LogConsole::Level::Debug, line);
+            for (const auto &warning : this->m_internals.optimizer->getWarnings())
+                evaluator->getConsole().log(core::LogConsole::Level::Warning, warning);
+        }
 
         this->m_internals.preprocessor->setStoredErrors(this->m_compileErrors);
 
@@ -190,8 +265,94 @@ namespace pl {
         return m_currAST;
     }
 
+    std::optional<CompiledPattern> PatternLanguage::compile(const std::string &code, const std::string &source) {
+        auto ast = this->parseString(code, source);
+        if (!ast.has_value() || !this->m_compileErrors.empty())
+            return std::nullopt;
+
+        auto data = std::make_shared<CompiledPattern::Data>();
+        data->source    = source;
+        data->ast       = std::move(*ast);
+        data->functions = this->m_functions;
+
+        // Flatten the top-level statements once, every execution of the compiled pattern walks the same list
+        data->statements = core::Evaluator::flattenStatements(data->ast);
+
+        // Take ownership of all parsed types so resetting this runtime doesn't tear them down while the compiled pattern is still alive
+        data->types.emplace_back(this->m_internals.parser->extractTypes());
+        for (auto &[onceIncludePair, types] : this->m_parserManager.extractParsedTypes())
+            data->types.emplace_back(std::move(types));
+
+        // Remember the pragmas that were set so they can be applied to the runtime again on every execution
+        for (const auto &[type, entries] : this->m_internals.preprocessor->getPragmas()) {
+            if (!this->m_pragmas.contains(type))
+                continue;
+
+            for (const auto &[value, line] : entries)
+                data->pragmas.emplace_back(type, value);
+        }
+
+        CompiledPattern result;
+        result.m_data = std::move(data);
+
+        return result;
+    }
+
+    int PatternLanguage::execute(const CompiledPattern &pattern, const std::map<std::string, core::Token::Literal> &envVars, const std::map<std::string, core::Token::Literal> &inVariables, bool checkResult) {
+        if (!pattern.isValid())
+            return EXIT_FAILURE;
+
+        // Keep the function list of the compiled pattern alive so its address can identify the functions that were registered already
+        this->m_registeredPatternData = pattern.m_data;
+
+        const auto &data = *pattern.m_data;
+        return this->executeImpl([&] {
+            this->reset();
+
+            for (const auto &[type, value] : data.pragmas) {
+                if (auto it = this->m_pragmas.find(type); it != this->m_pragmas.end())
+                    (void)it->second(*this, value);
+            }
+
+            this->m_currAST = data.ast;
+            this->m_currStatements = data.statements;
+
+            return true;
+        }, data.functions, envVars, inVariables, checkResult);
+    }
+
     int PatternLanguage::executeString(const std::string& code, const std::string& source, const std::map<std::string, core::Token::Literal> &envVars, const std::map<std::string, core::Token::Literal> &inVariables, bool checkResult) {
-	   	const auto startTime = std::chrono::high_resolution_clock::now();
+        return this->executeImpl([&] {
+            auto ast = this->parseString(code, source);
+            if (!ast.has_value())
+                return false;
+            // do not continue execution if there are any compile errors
+            if (!this->m_compileErrors.empty())
+                return false;
+
+            this->m_currAST = std::move(*ast);
+            this->m_currStatements = core::Evaluator::flattenStatements(this->m_currAST);
+
+            return true;
+        }, this->m_functions, envVars, inVariables, checkResult);
+    }
+
+    void PatternLanguage::registerBuiltinFunctions(const std::vector<Function> &functions) {
+        if (this->m_registeredFunctions != &functions || this->m_registeredFunctionCount > functions.size()) {
+            this->m_registeredFunctions = &functions;
+            this->m_registeredFunctionCount = 0;
+        }
+
+        for (size_t i = this->m_registeredFunctionCount; i < functions.size(); i += 1) {
+            const auto &[ns, name, parameterCount, callback, dangerous] = functions[i];
+            this->m_internals.evaluator->addBuiltinFunction(getFunctionName(ns, name), parameterCount, { }, callback, dangerous);
+        }
+
+        this->m_registeredFunctionCount = functions.size();
+    }
+
+    int PatternLanguage::executeImpl(const std::function<bool()> &prepare, const std::vector<Function> &functions, const std::map<std::string, core::Token::Literal> &envVars, const std::map<std::string, core::Token::Literal> &inVariables, bool checkResult) {
+        const auto startTime = std::chrono::high_resolution_clock::now();
         ON_SCOPE_EXIT {
             const auto endTime = std::chrono::high_resolution_clock::now();
             this->m_runningTime = std::chrono::duration_cast<std::chrono::duration<double>>(endTime - startTime).count();
@@ -226,39 +387,40 @@ namespace pl {
         for (const auto &[name, value] : envVars)
             evaluator->setEnvVariable(name, value);
 
-        auto ast = this->parseString(code, source);
-        if (!ast.has_value())
-            return EXIT_FAILURE;
-        // do not continue execution if there are any compile errors
-        if (!this->m_compileErrors.empty())
+        if (!prepare())
             return EXIT_FAILURE;
 
-        this->m_currAST = std::move(*ast);
-
-        for (const auto &[ns, name, parameterCount, callback, dangerous] : this->m_functions) {
-            this->m_internals.evaluator->addBuiltinFunction(getFunctionName(ns, name), parameterCount, { }, callback, dangerous);
-        }
+        this->registerBuiltinFunctions(functions);
 
         std::optional<std::function<void(u64, const u8*, size_t)>> writeFunction;
         if (m_dataWriteFunction.has_value()) {
             writeFunction = [this](u64 address, const u8 *buffer, size_t size) {
+                this->m_dataCache.invalidate(address + this->getStartAddress(), size);
+
                 return (*this->m_dataWriteFunction)(address + this->getStartAddress(), buffer, size);
             };
         }
 
-        evaluator->setDataSource(this->m_dataBaseAddress, this->m_dataSize,
-            [this](u64 address, u8 *buffer, size_t size) {
-                return this->m_dataReadFunction(address + this->getStartAddress(), buffer, size);
-            },
-            writeFunction
-        );
+        if (this->m_dataSpan.data() != nullptr) {
+            evaluator->setDataSource(this->m_dataBaseAddress, this->m_dataSize, this->m_dataSpan, this->m_dataBaseAddress - this->getStartAddress(), writeFunction);
+        } else {
+            evaluator->setDataSource(this->m_dataBaseAddress, this->m_dataSize,
+                [this](u64 address, u8 *buffer, size_t size) {
+                    const auto dataStart = this->m_dataBaseAddress;
+                    const auto dataEnd   = this->m_dataBaseAddress + this->m_dataSize;
+
+                    return this->m_dataCache.read(address + this->getStartAddress(), buffer, size, dataStart, dataEnd, this->m_dataReadFunction);
+                },
+                writeFunction
+            );
+        }
 
         evaluator->setStartAddress(this->getStartAddress());
         evaluator->setReadOffset(evaluator->getDataBaseAddress());
         evaluator->setDangerousFunctionCallHandler(this->m_dangerousFunctionCallCallback);
 
         int evaluationResult = EXIT_SUCCESS;
-        if (!evaluator->evaluate(this->m_currAST)) {
+        if (!evaluator->evaluate(this->m_currAST, this->m_currStatements)) {
             auto &console = evaluator->getConsole();
 
             this->m_currError = console.getLastHardError();
@@ -304,7 +466,7 @@ namespace pl {
             this->m_patterns[pattern->getSection()].push_back(pattern);
 
         for (const auto &pattern : this->m_patterns[ptrn::Pattern::HeapSectionId]) {
-            if (pattern->hasAttribute("export")) {
+            if (pattern->isExported()) {
                 this->m_patterns[ptrn::Pattern::MainSectionId].emplace_back(pattern);
             }
         }
@@ -409,6 +571,25 @@ namespace pl {
         this->m_dataSize = size;
         this->m_dataReadFunction = std::move(readFunction);
         this->m_dataWriteFunction = std::move(writeFunction);
+        this->m_dataSpan = { };
+        this->m_dataCache.clear();
+    }
+
+    void PatternLanguage::setDataSource(u64 baseAddress, std::span<const u8> data, std::optional<std::function<void(u64, const u8*, size_t)>> writeFunction) {
+        this->m_dataBaseAddress = baseAddress;
+        this->m_dataSize = data.size();
+        this->m_dataWriteFunction = std::move(writeFunction);
+        this->m_dataSpan = data;
+        this->m_dataCache.clear();
+
+        // Only used by code that reads through the callback directly
+        this->m_dataReadFunction = [baseAddress, data](u64 address, u8 *buffer, size_t size) {
+            const auto index = address - baseAddress;
+            if (index < data.size() && size <= data.size() - index)
+                std::memcpy(buffer, data.data() + index, size);
+            else
+                std::memset(buffer, 0x00, size);
+        };
     }
 
     const std::atomic<u64>& PatternLanguage::getLastReadAddress() const {
@@ -423,12 +604,22 @@ namespace pl {
         return this->m_internals.evaluator->getLastPatternPlaceAddress();
     }
 
+    void PatternLanguage::setDataCache(size_t pageSize, size_t pageCount) {
+        this->m_dataCache.configure(pageSize, pageCount);
+    }
+
+    void PatternLanguage::invalidateDataRange(u64 address, size_t size) {
+        this->m_dataCache.invalidate(address, size);
+    }
+
     void PatternLanguage::setDataBaseAddress(u64 baseAddress) {
         this->m_dataBaseAddress = baseAddress;
+        this->m_dataCache.clear();
     }
 
     void PatternLanguage::setDataSize(u64 size) {
         this->m_dataSize = size;
+        this->m_dataCache.clear();
     }
 
     void PatternLanguage::setDefaultEndian(std::endian endian) {
@@ -500,6 +691,7 @@ namespace pl {
             this->m_flattenThread.join();
         this->m_patterns.clear();
         this->m_flattenedPatterns.clear();
+        this->m_stridedHighlights.clear();
         this->m_flattenedPatternsValid = false;
 
         this->m_currError.reset();
@@ -514,6 +706,7 @@ namespace pl {
         this->m_internals.evaluator->setDefaultEndian(this->m_defaultEndian);
         this->m_internals.evaluator->setEvaluationDepth(32);
         this->m_internals.evaluator->setArrayLimit(0x10000);
+        this->m_internals.evaluator->setLazyEntryLimit(0x1000);
         this->m_internals.evaluator->setPatternLimit(0x100000);
         this->m_internals.evaluator->setLoopLimit(0x1000);
         this->m_internals.evaluator->setDebugMode(false);
@@ -545,12 +738,87 @@ namespace pl {
         this->m_parserManager.addBuiltinType(getFunctionName(ns, name), parameterCount, func);
     }
 
+    // Splits the intervals of a section up into shards covering consecutive address ranges and builds their interval trees in parallel.
+    // Intervals that reach into following shards are inserted into those as well so a lookup only ever needs to check a single shard
+    PatternLanguage::FlattenedSection PatternLanguage::buildFlattenedSection(std::vector<FlattenedInterval> &intervals, const std::atomic<bool> &aborted) {
+        constexpr static size_t MinimumShardSize = 0x10000;
+
+        FlattenedSection result;
+        if (intervals.empty())
+            return result;
+
+        std::ranges::sort(intervals, {}, &FlattenedInterval::start);
+
+        const size_t maxShardCount = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+        const size_t shardCount = std::clamp<size_t>(intervals.size() / MinimumShardSize, 1, maxShardCount);
+
+        // Pick shard boundaries so every shard starts out with roughly the same number of intervals
+        std::vector<size_t> shardFirstInterval;
+        for (size_t i = 0; i < shardCount; i += 1) {
+            const auto first = i * intervals.size() / shardCount;
+            const auto start = i == 0 ? 0 : intervals[first].start;
+
+            if (!result.shardStarts.empty() && result.shardStarts.back() == start)
+                continue;
+
+            // Make sure all intervals with the same start address end up in the same shard
+            const auto firstInterval = std::ranges::lower_bound(intervals, start, {}, &FlattenedInterval::start) - intervals.begin();
+
+            result.shardStarts.push_back(start);
+            shardFirstInterval.push_back(i == 0 ? 0 : firstInterval);
+        }
+        shardFirstInterval.push_back(intervals.size());
+
+        // Collect intervals that spill over into the following shards
+        std::vector<std::vector<const FlattenedInterval*>> spilledIntervals(result.shardStarts.size());
+        for (size_t shard = 0; shard + 1 < result.shardStarts.size(); shard += 1) {
+            for (size_t i = shardFirstInterval[shard]; i < shardFirstInterval[shard + 1]; i += 1) {
+                const auto &interval = intervals[i];
+                for (size_t nextShard = shard + 1; nextShard < result.shardStarts.size() && result.shardStarts[nextShard] <= interval.end; nextShard += 1)
+                    spilledIntervals[nextShard].push_back(&interval);
+            }
+        }
+
+        result.shards.resize(result.shardStarts.size());
+
+        const auto buildShard = [&](size_t shard) {
+            auto &tree = result.shards[shard];
+
+            for (const auto interval : spilledIntervals[shard])
+                tree.insert({ interval->start, interval->end }, interval->pattern);
+
+            for (size_t i = shardFirstInterval[shard]; i < shardFirstInterval[shard + 1]; i += 1) {
+                if (aborted)
+                    return;
+
+                const auto &interval = intervals[i];
+                tree.insert({ interval.start, interval.end }, interval.pattern);
+            }
+        };
+
+        std::vector<std::thread> shardThreads;
+        for (size_t shard = 1; shard < result.shards.size(); shard += 1)
+            shardThreads.emplace_back(buildShard, shard);
+
+        buildShard(0);
+
+        for (auto &thread : shardThreads)
+            thread.join();
+
+        return result;
+    }
+
     void PatternLanguage::flattenPatterns() {
+        // Collect the intervals of all highlighted patterns on the calling thread. Walking the patterns creates the highlight templates of arrays,
+        // and creating a pattern interns its name and registers it with the evaluator. Neither of these is synchronized, and the caller is free
+        // to use the evaluator again as soon as execution returns, for example to run format functions of the patterns it displays
+        std::map<u64, std::vector<FlattenedInterval>> sectionIntervals;
+        this->m_stridedHighlights.clear();
         for (const auto &[section, patterns] : this->m_patterns) {
             if (this->m_aborted)
                 return;
 
-            auto &sectionTree = this->m_flattenedPatterns[section];
+            auto &intervals = sectionIntervals[section];
             for (const auto &pattern : patterns) {
                 if (this->m_aborted)
                     return;
@@ -558,71 +826,187 @@ namespace pl {
                 if (pattern->getVisibility() == ptrn::Visibility::Hidden || pattern->getVisibility() == ptrn::Visibility::HighlightHidden)
                     continue;
 
-                if (auto staticArray = dynamic_cast<ptrn::PatternArrayStatic*>(pattern.get()); staticArray != nullptr) {
+                if (auto staticArray = ptrn::pattern_cast<ptrn::PatternArrayStatic>(pattern.get()); staticArray != nullptr) {
                     if (staticArray->getEntryCount() > 0 && staticArray->getEntry(0)->getChildren().empty()) {
-                        if (this->m_aborted)
-                            return;
-
                         const auto address = staticArray->getOffset();
                         const auto size = staticArray->getSize();
-                        sectionTree.insert({ address, address + size - 1 }, staticArray);
+                        intervals.push_back({ address, address + size - 1, staticArray });
                         continue;
                     }
                 }
 
-                auto children = pattern->getChildren();
-                for (const auto &[address, child] : children) {
-                    if (this->m_aborted)
-                        return;
+                this->collectFlattenedIntervals(pattern->getHighlightChildren(), 0x00, std::numeric_limits<u64>::max(), intervals);
+            }
+        }
 
-                    if (child->getSize() == 0)
-                        continue;
+        // Building the interval trees only works on the collected intervals, so it can run in the background
+        if (this->m_flattenThread.joinable())
+            this->m_flattenThread.join();
 
-                    if (child->getVisibility() == ptrn::Visibility::Hidden || child->getVisibility() == ptrn::Visibility::HighlightHidden)
-                        continue;
+        this->m_flattenedPatternsValid = false;
+        this->m_flattenThread = std::thread([this, sectionIntervals = std::move(sectionIntervals)]() mutable {
+            ON_SCOPE_EXIT {
+                this->m_flattenedPatternsValid = true;
+                this->m_flattenedPatternsValid.notify_all();
+            };
 
-                    sectionTree.insert({ address, address + child->getSize() - 1 }, child);
-                }
+            std::map<u64, std::future<FlattenedSection>> sectionFutures;
+            for (auto &[section, intervals] : sectionIntervals) {
+                sectionFutures.emplace(section, std::async(std::launch::async, [this, &intervals] {
+                    return buildFlattenedSection(intervals, this->m_aborted);
+                }));
             }
-        }
+
+            for (auto &[section, future] : sectionFutures)
+                this->m_flattenedPatterns[section] = future.get();
+        });
     }
 
-    std::vector<ptrn::Pattern *> PatternLanguage::getPatternsAtAddress(u64 address, u64 section) const {
-        if (this->m_flattenedPatterns.empty() || !this->m_flattenedPatterns.contains(section))
-            return { };
+    void PatternLanguage::collectFlattenedIntervals(const std::vector<std::pair<u64, ptrn::Pattern*>> &children, u64 origin, u64 limit, std::vector<FlattenedInterval> &intervals) {
+        for (const auto &[address, child] : children) {
+            if (child->getSize() == 0)
+                continue;
 
-        auto intervals = this->m_flattenedPatterns.at(section).overlapping({ address, address });
+            if (child->getVisibility() == ptrn::Visibility::Hidden || child->getVisibility() == ptrn::Visibility::HighlightHidden)
+                continue;
 
-        std::vector<ptrn::Pattern*> results;
-        std::transform(intervals.begin(), intervals.end(), std::back_inserter(results), [](const auto &interval) {
-            ptrn::Pattern* value = interval.value;
+            // Children outside of a strided entry (e.g. things pointed to by pointers) cannot be repeated with it
+            if (address < origin || address - origin + child->getSize() > limit)
+                continue;
 
-            auto parent = value->getParent();
-            while (parent != nullptr && dynamic_cast<const ptrn::PatternArrayStatic*>(parent->getParent()) == nullptr) {
-                parent = parent->getParent();
-            }
+            const auto start = address - origin;
+            intervals.push_back({ start, start + child->getSize() - 1, child });
+
+            if (child->isSealed())
+                continue;
 
-            // Handle static array members
-            if (parent != nullptr) {
-                parent->setOffset(interval.interval.start - (value->getOffset() - parent->getOffset()));
-                parent->clearFormatCache();
-                value->clearFormatCache();
+            if (auto staticArray = ptrn::pattern_cast<ptrn::PatternArrayStatic>(child); staticArray != nullptr)
+                this->addStridedHighlight(staticArray, staticArray->getHighlightTemplate(), staticArray->getEntryCount());
+            else if (auto dynamicArray = ptrn::pattern_cast<ptrn::PatternArrayDynamic>(child); dynamicArray != nullptr) {
+                if (const auto templateRoot = dynamicArray->getHighlightTemplate(); templateRoot != nullptr)
+                    this->addStridedHighlight(dynamicArray, templateRoot, dynamicArray->getEntryCount());
             }
+        }
+    }
 
-            return value;
-        });
+    void PatternLanguage::addStridedHighlight(ptrn::Pattern *array, const std::shared_ptr<ptrn::Pattern> &templateRoot, u64 count) {
+        if (this->m_stridedHighlights.contains(array))
+            return;
+
+        const auto stride = templateRoot->getSize();
+
+        // Children are stored relative to the start of an entry
+        std::vector<FlattenedInterval> intervals;
+        this->collectFlattenedIntervals(templateRoot->getHighlightChildren(), templateRoot->getOffset(), stride, intervals);
+
+        StridedHighlight highlight = { templateRoot.get(), stride, count, { } };
+        for (const auto &[start, end, pattern] : intervals)
+            highlight.children.insert({ start, end }, pattern);
+
+        this->m_stridedHighlights.emplace(array, std::move(highlight));
+    }
+
+    void PatternLanguage::resolveFlattenedPattern(ptrn::Pattern *pattern, u64 start, u64 address, bool updateOffsets, std::vector<ptrn::Pattern*> &results) const {
+        const auto it = this->m_stridedHighlights.find(pattern);
+        if (it == this->m_stridedHighlights.end()) {
+            results.push_back(pattern);
+            return;
+        }
+
+        const auto &[templateRoot, stride, count, children] = it->second;
+        if (stride == 0)
+            return;
+
+        const auto index = (address - start) / stride;
+        if (index >= count)
+            return;
+
+        // Move the highlight template to the entry the address is in so the returned patterns show the right values
+        const auto entryStart = start + index * stride;
+        if (updateOffsets) {
+            templateRoot->setOffset(entryStart);
+            templateRoot->clearFormatCache();
+        }
+
+        const auto relativeAddress = address - entryStart;
+        for (const auto &[interval, child] : children.overlapping({ relativeAddress, relativeAddress }))
+            this->resolveFlattenedPattern(child, entryStart + interval.start, address, updateOffsets, results);
+    }
+
+    void PatternLanguage::resolveFlattenedRange(ptrn::Pattern *pattern, u64 patternStart, u64 patternEnd, u64 start, u64 end, std::vector<PatternSpan> &results) const {
+        const auto it = this->m_stridedHighlights.find(pattern);
+        if (it == this->m_stridedHighlights.end()) {
+            results.push_back({ patternStart, patternEnd, pattern });
+            return;
+        }
+
+        const auto &[templateRoot, stride, count, children] = it->second;
+        if (stride == 0 || count == 0)
+            return;
+
+        // Only visit the entries that actually overlap with the requested range
+        const auto rangeStart = std::max(start, patternStart);
+        const auto rangeEnd   = std::min(end, patternEnd);
+        const auto firstIndex = (rangeStart - patternStart) / stride;
+        const auto lastIndex  = std::min<u64>((rangeEnd - patternStart) / stride, count - 1);
+
+        for (u64 index = firstIndex; index <= lastIndex; index += 1) {
+            const auto entryStart = patternStart + index * stride;
+            const auto entryEnd   = entryStart + stride - 1;
+
+            const auto relativeStart = std::max(rangeStart, entryStart) - entryStart;
+            const auto relativeEnd   = std::min(rangeEnd, entryEnd) - entryStart;
+            for (const auto &[interval, child] : children.overlapping({ relativeStart, relativeEnd }))
+                this->resolveFlattenedRange(child, entryStart + interval.start, entryStart + interval.end, start, end, results);
+        }
+    }
+
+    void PatternLanguage::waitForFlattenedPatterns() const {
+        if (this->m_flattenThread.joinable())
+            this->m_flattenedPatternsValid.wait(false);
+    }
+
+    const PatternLanguage::PatternIntervalTree* PatternLanguage::getFlattenedPatternTree(u64 address, u64 section) const {
+        this->waitForFlattenedPatterns();
+
+        const auto sectionIt = this->m_flattenedPatterns.find(section);
+        if (sectionIt == this->m_flattenedPatterns.end())
+            return nullptr;
+
+        const auto &[shardStarts, shards] = sectionIt->second;
+        if (shards.empty())
+            return nullptr;
+
+        // Find the shard responsible for this address. The first shard always starts at address 0
+        const auto shardIt = std::ranges::upper_bound(shardStarts, address);
+        const auto shardIndex = std::distance(shardStarts.begin(), shardIt) - 1;
+
+        return &shards[shardIndex];
+    }
+
+    std::vector<ptrn::Pattern *> PatternLanguage::getPatternsAtAddress(u64 address, u64 section) const {
+        const auto tree = this->getFlattenedPatternTree(address, section);
+        if (tree == nullptr)
+            return { };
+
+        std::vector<ptrn::Pattern*> results;
+        for (const auto &[interval, pattern] : tree->overlapping({ address, address }))
+            this->resolveFlattenedPattern(pattern, interval.start, address, true, results);
 
         return results;
     }
 
     std::vector<u32> PatternLanguage::getColorsAtAddress(u64 address, u64 section) const {
-        if (this->m_flattenedPatterns.empty() || !this->m_flattenedPatterns.contains(section))
+        const auto tree = this->getFlattenedPatternTree(address, section);
+        if (tree == nullptr)
             return { };
 
-        auto intervals = this->m_flattenedPatterns.at(section).overlapping({ address, address });
+        std::vector<ptrn::Pattern*> patterns;
+        for (const auto &[interval, pattern] : tree->overlapping({ address, address }))
+            this->resolveFlattenedPattern(pattern, interval.start, address, false, patterns);
 
         std::vector<u32> results;
-        for (auto &[interval, pattern] : intervals) {
+        for (const auto pattern : patterns) {
             auto visibility = pattern->getVisibility();
             if (visibility == pl::ptrn::Visibility::Hidden || visibility == pl::ptrn::Visibility::HighlightHidden)
                 continue;
@@ -633,6 +1017,107 @@ namespace pl {
         return results;
     }
 
+    std::vector<PatternLanguage::PatternSpan> PatternLanguage::getPatternsInRange(u64 start, u64 end, u64 section) const {
+        if (start > end)
+            return { };
+
+        this->waitForFlattenedPatterns();
+
+        const auto sectionIt = this->m_flattenedPatterns.find(section);
+        if (sectionIt == this->m_flattenedPatterns.end())
+            return { };
+
+        const auto &[shardStarts, shards] = sectionIt->second;
+        if (shards.empty())
+            return { };
+
+        const auto firstShard = std::distance(shardStarts.begin(), std::ranges::upper_bound(shardStarts, start)) - 1;
+        const auto lastShard  = std::distance(shardStarts.begin(), std::ranges::upper_bound(shardStarts, end)) - 1;
+
+        std::vector<PatternSpan> results;
+        for (auto shard = firstShard; shard <= lastShard; shard += 1) {
+            for (const auto &[interval, pattern] : shards[shard].overlapping({ start, end })) {
+                // Intervals that spilled over from a previous shard have already been visited there
+                if (shard != firstShard && interval.start < shardStarts[shard])
+                    continue;
+
+                this->resolveFlattenedRange(pattern, interval.start, interval.end, start, end, results);
+            }
+        }
+
+        std::ranges::sort(results, [](const PatternSpan &a, const PatternSpan &b) {
+            return std::tie(a.start, a.end, a.pattern) < std::tie(b.start, b.end, b.pattern);
+        });
+        const auto duplicates = std::ranges::unique(results, [](const PatternSpan &a, const PatternSpan &b) {
+            return a.start == b.start && a.end == b.end && a.pattern == b.pattern;
+        });
+        results.erase(duplicates.begin(), duplicates.end());
+
+        return results;
+    }
+
+    std::vector<PatternLanguage::ColorRun> PatternLanguage::getColorsInRange(u64 start, u64 end, u64 section) const {
+        if (start > end)
+            return { };
+
+        struct Event {
+            u64 address;
+            bool begin;
+            size_t span;
+        };
+
+        // Turn all visible spans into begin and end events and sweep over them once
+        const auto spans = this->getPatternsInRange(start, end, section);
+        std::vector<Event> events;
+        events.reserve(spans.size() * 2);
+        for (size_t i = 0; i < spans.size(); i += 1) {
+            const auto visibility = spans[i].pattern->getVisibility();
+            if (visibility == ptrn::Visibility::Hidden || visibility == ptrn::Visibility::HighlightHidden)
+                continue;
+
+            events.push_back({ std::max(spans[i].start, start), true, i });
+            if (spans[i].end < end)
+                events.push_back({ spans[i].end + 1, false, i });
+        }
+        std::ranges::sort(events, {}, &Event::address);
+
+        std::vector<ColorRun> results;
+        std::vector<size_t> activeSpans;
+        u64 runStart = start;
+
+        const auto emitRun = [&](u64 runEnd) {
+            std::vector<u32> colors;
+            colors.reserve(activeSpans.size());
+            for (const auto span : activeSpans)
+                colors.push_back(spans[span].pattern->getColor());
+
+            if (!results.empty() && results.back().colors == colors)
+                results.back().end = runEnd;
+            else
+                results.push_back({ runStart, runEnd, std::move(colors) });
+        };
+
+        for (size_t i = 0; i < events.size();) {
+            const auto address = events[i].address;
+            if (address > runStart)
+                emitRun(address - 1);
+
+            // Apply all events at this address before starting the next run
+            for (; i < events.size() && events[i].address == address; i += 1) {
+                if (events[i].begin)
+                    activeSpans.insert(std::ranges::upper_bound(activeSpans, events[i].span), events[i].span);
+                else
+                    activeSpans.erase(std::ranges::lower_bound(activeSpans, events[i].span));
+            }
+
+            runStart = address;
+        }
+
+        emitRun(end);
+
+        return results;
+    }
+
     const std::set<ptrn::Pattern*>& PatternLanguage::getPatternsWithAttribute(const std::string &attribute) const {
         return m_internals.evaluator->getPatternsWithAttribute(attribute);
     }
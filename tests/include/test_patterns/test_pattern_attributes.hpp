@@ -55,6 +55,10 @@ namespace pl::test {
                     std::assert($ == pos + 4, "Fixed size pattern attribute padding not working");
                 };
 
+                struct SharedAttributesTest {
+                    u8 value [[comment("Shared"), name("Value")]];
+                };
+
                 FormatTransformTest formatTransformTest @ 0x00;
                 SealedTest sealedTest @ 0x10;
                 HiddenTest hiddenTest @ 0x20;
@@ -62,6 +66,7 @@ namespace pl::test {
                 NoUniqueAddressTest noUniqueAddressTest @ 0x40;
                 FixedSizeTest1 fixedSizeTest1 @ 0x50;
                 FixedSizeTest2 fixedSizeTest2 @ 0x60;
+                SharedAttributesTest sharedAttributesTest[2] @ 0x70;
 
                 std::assert(formatTransformTest == 1337, "Transform attribute not working");
                 std::assert(sizeof(noUniqueAddressTest) == sizeof(u32), "No Unique Address attribute not working");
@@ -85,6 +90,16 @@ namespace pl::test {
                 } else if (varName == "colorTest") {
                     if (pattern->getColor() != 0xFF00FF)
                         return false;
+                } else if (varName == "sharedAttributesTest") {
+                    // Patterns of the same declaration with constant attributes share a single attribute set
+                    auto array = dynamic_cast<IIterable*>(pattern.get());
+                    auto first = dynamic_cast<IIterable*>(array->getEntry(0).get())->getEntry(0);
+                    auto second = dynamic_cast<IIterable*>(array->getEntry(1).get())->getEntry(0);
+
+                    if (first->getAttributes() == nullptr || first->getAttributes() != second->getAttributes())
+                        return false;
+                    if (second->getDisplayName() != "Value" || second->getComment() != "Shared")
+                        return false;
                 }
             }
 
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "test_pattern.hpp"
+
+#include <pl/pattern_language.hpp>
+
+namespace pl::test {
+
+    class TestPatternCallTargets : public TestPattern {
+    public:
+        TestPatternCallTargets(core::Evaluator *evaluator) : TestPattern(evaluator, "CallTargets") {
+        }
+        ~TestPatternCallTargets() override = default;
+
+        void setup() override {
+            this->m_runtime->addFunction({ "test" }, "value", api::FunctionParameterCount::none(), [](core::Evaluator *, auto) -> std::optional<core::Token::Literal> {
+                return u128(1);
+            });
+        }
+
+        [[nodiscard]] std::string getSourceCode() const override {
+            return R"(
+                fn call() {
+                    return test::value();
+                };
+
+                // The call site first resolves to the builtin function. Every run starts out without the function defined below
+                std::assert(call() == 1, "Builtin function call error");
+
+                namespace test {
+                    fn value() {
+                        return 2;
+                    };
+                }
+
+                // Defining a function drops all resolved call targets so it shadows the builtin one
+                std::assert(call() == 2, "Redefined function call error");
+            )";
+        }
+    };
+
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include "test_pattern.hpp"
+
+#include <pl/pattern_language.hpp>
+#include <pl/core/ast/ast_node_conditional_statement.hpp>
+#include <pl/core/ast/ast_node_function_definition.hpp>
+
+namespace pl::test {
+
+    class TestPatternConstantConditions : public TestPattern {
+    public:
+        TestPatternConstantConditions(core::Evaluator *evaluator) : TestPattern(evaluator, "ConstantConditions") {
+        }
+        ~TestPatternConstantConditions() override = default;
+
+        [[nodiscard]] std::string getSourceCode() const override {
+            return R"(
+                u32 counter = 0;
+
+                fn folded() {
+                    if (2 * 4 == 8)
+                        counter = counter + 1;
+                    else
+                        counter = counter + 100;
+
+                    if (1 - 1)
+                        counter = counter + 1000;
+
+                    return counter;
+                };
+
+                struct Folded {
+                    if (sizeof(u32) == 4) {
+                        u8 present;
+                        counter = counter + 10;
+                    } else {
+                        u16 absent;
+                    }
+
+                    if (false)
+                        u8 never;
+                };
+
+                std::assert(folded() == 1, "Constant condition side effect error");
+                std::assert(folded() == 2, "Repeated constant condition side effect error");
+
+                Folded folded @ 0x00;
+
+                std::assert(sizeof(folded) == 1, "Constant condition member error");
+                std::assert(counter == 12, "Constant condition member side effect error");
+            )";
+        }
+
+        [[nodiscard]] bool runChecks(const std::vector<std::shared_ptr<ptrn::Pattern>> &patterns) const override {
+            // Only the member of the branch that's always taken gets placed
+            if (patterns.size() != 1)
+                return false;
+
+            const auto folded = dynamic_cast<ptrn::IIterable*>(patterns.front().get());
+            if (folded == nullptr || folded->getEntryCount() != 1 || folded->getEntry(0)->getVariableName() != "present")
+                return false;
+
+            // Folded conditions keep both of their bodies in the tree
+            for (const auto &node : this->m_runtime->getAST()) {
+                const auto function = dynamic_cast<core::ast::ASTNodeFunctionDefinition*>(node.get());
+                if (function == nullptr || function->getName() != "folded")
+                    continue;
+
+                const auto conditional = dynamic_cast<core::ast::ASTNodeConditionalStatement*>(function->getBody().front().get());
+                if (conditional == nullptr)
+                    return false;
+
+                return conditional->getConstantCondition() == true && !conditional->getTrueBody().empty() && !conditional->getFalseBody().empty();
+            }
+
+            return false;
+        }
+    };
+
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "test_pattern.hpp"
+
+#include <pl/pattern_language.hpp>
+
+#include <algorithm>
+
+namespace pl::test {
+
+    class TestPatternFlattenedPatterns : public TestPattern {
+    public:
+        TestPatternFlattenedPatterns(core::Evaluator *evaluator) : TestPattern(evaluator, "FlattenedPatterns") {
+        }
+        ~TestPatternFlattenedPatterns() override = default;
+
+        [[nodiscard]] std::string getSourceCode() const override {
+            return R"(
+                struct Header {
+                    u8 magic[4];
+                    be u32 length;
+                };
+
+                Header header @ 0x00;
+                u16 trailer @ 0x20;
+                u32 hidden @ 0x30 [[hidden]];
+            )";
+        }
+
+        [[nodiscard]] bool runChecks(const std::vector<std::shared_ptr<ptrn::Pattern>> &patterns) const override {
+            const auto trailer = std::ranges::find_if(patterns, [](const auto &pattern) { return pattern->getVariableName() == "trailer"; });
+            if (trailer == patterns.end())
+                return false;
+
+            // Lookups wait for the interval trees that are built in the background
+            const auto lengthPatterns = this->m_runtime->getPatternsAtAddress(0x05);
+            if (!this->m_runtime->arePatternsFlattened())
+                return false;
+            if (lengthPatterns.size() != 1 || lengthPatterns.front()->getVariableName() != "length")
+                return false;
+
+            const auto magicPatterns = this->m_runtime->getPatternsAtAddress(0x02);
+            if (magicPatterns.size() != 1 || magicPatterns.front()->getOffset() != 0x02)
+                return false;
+
+            const auto trailerPatterns = this->m_runtime->getPatternsAtAddress(0x21);
+            if (trailerPatterns.size() != 1 || trailerPatterns.front() != trailer->get())
+                return false;
+
+            const auto colors = this->m_runtime->getColorsAtAddress(0x05);
+            if (colors.size() != 1 || colors.front() != lengthPatterns.front()->getColor())
+                return false;
+
+            // Gaps and hidden patterns aren't part of the trees
+            if (!this->m_runtime->getPatternsAtAddress(0x10).empty() || !this->m_runtime->getPatternsAtAddress(0x31).empty())
+                return false;
+
+            return true;
+        }
+    };
+
+}
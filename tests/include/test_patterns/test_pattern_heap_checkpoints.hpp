@@ -0,0 +1,79 @@
+#pragma once
+
+#include "test_pattern.hpp"
+
+#include <pl/pattern_language.hpp>
+
+namespace pl::test {
+
+    class TestPatternHeapCheckpoints : public TestPattern {
+    public:
+        TestPatternHeapCheckpoints(core::Evaluator *evaluator) : TestPattern(evaluator, "HeapCheckpoints") {
+        }
+        ~TestPatternHeapCheckpoints() override = default;
+
+        [[nodiscard]] std::string getSourceCode() const override {
+            return R"(
+                u32 counter = 0;
+
+                fn countdown(u32 n) {
+                    u32 local = n;
+                    if (n == 0)
+                        return 0;
+
+                    return local + countdown(n - 1);
+                };
+
+                fn transform_value(u8 value) {
+                    u32 local = countdown(4);
+                    counter = counter + 100;
+
+                    if (value == 0x89)
+                        return local;
+
+                    return local + value;
+                };
+
+                fn format_value(u8 value) {
+                    u32 local = countdown(3);
+                    counter = local;
+
+                    return "formatted";
+                };
+
+                struct Values {
+                    u8 first [[transform("transform_value")]];
+                    u8 second [[transform("transform_value")]];
+                };
+
+                Values values @ 0x00;
+                u8 formatted @ 0x02 [[format("format_value")]];
+
+                // Both the early return and the regular one leave the heap untouched
+                std::assert(values.first == 10, "Transform with early return error");
+                std::assert(values.second == 10 + 0x50, "Transform error");
+                std::assert(counter == 0, "Transform function modified the heap");
+
+                u32 local = 5;
+                std::assert(countdown(local) == 15 && local == 5, "Recursion error");
+            )";
+        }
+
+        [[nodiscard]] bool runChecks(const std::vector<std::shared_ptr<ptrn::Pattern>> &patterns) const override {
+            const auto &heap = this->m_runtime->getInternals().evaluator->getHeap();
+            const auto heapBefore = heap;
+
+            // Formatter functions run after evaluation finished and may not change any variables either
+            for (const auto &pattern : patterns) {
+                if (pattern->getVariableName() == "formatted") {
+                    pattern->clearFormatCache();
+                    if (pattern->getFormattedValue() != "formatted")
+                        return false;
+                }
+            }
+
+            return heap == heapBefore;
+        }
+    };
+
+}
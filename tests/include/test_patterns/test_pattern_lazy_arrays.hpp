@@ -0,0 +1,58 @@
+#pragma once
+
+#include "test_pattern.hpp"
+
+namespace pl::test {
+
+    class TestPatternLazyArrays : public TestPattern {
+    public:
+        TestPatternLazyArrays(core::Evaluator *evaluator) : TestPattern(evaluator, "LazyArrays") {
+        }
+        ~TestPatternLazyArrays() override = default;
+
+        [[nodiscard]] std::string getSourceCode() const override {
+            return R"(
+                #pragma lazy_entry_limit 2
+
+                struct Record {
+                    u8 length;
+                    u8 data[length];
+                };
+
+                Record lazyRecords[8] @ 0x00 [[lazy]];
+                Record records[8] @ 0x00;
+
+                std::assert(sizeof(lazyRecords) == sizeof(records), "Lazy array size error");
+
+                fn compareRecords() {
+                    u32 i = 0;
+                    while (i < 8) {
+                        std::assert(addressof(lazyRecords[i]) == addressof(records[i]), "Lazy entry offset error");
+                        std::assert(lazyRecords[i].length == records[i].length, "Lazy entry value error");
+                        std::assert(sizeof(lazyRecords[i].data) == sizeof(records[i].data), "Lazy entry size error");
+                        i = i + 1;
+                    }
+
+                    // Entries that have been evicted get created again
+                    std::assert(lazyRecords[0].length == records[0].length, "Evicted lazy entry error");
+                };
+
+                compareRecords();
+
+                // Entries of compact arrays that only differ in their offset are stored as locations
+                struct Pair {
+                    u8 first;
+                    if ($ >= 0)
+                        u8 second;
+                };
+
+                Pair pairs[16] @ 0x100 [[compact]];
+
+                std::assert(sizeof(pairs) == 16 * 2, "Compact array size error");
+                std::assert(addressof(pairs[15].second) == 0x11F, "Compact entry offset error");
+                std::assert(pairs[3].first == std::mem::read_unsigned(0x106, 1, 0), "Compact entry value error");
+            )";
+        }
+    };
+
+}
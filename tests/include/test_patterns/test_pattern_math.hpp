@@ -53,6 +53,38 @@ namespace pl::test {
 
                 std::assert(addressof(typeTest) == 0x100, "addressof operator error");
                 std::assert(sizeof(typeTest) == 3 * 4, "sizeof operator error");
+                std::assert(sizeof(TypeTest) == sizeof(typeTest), "sizeof type operator error");
+
+                // Constant expressions
+                struct ConstantTest { u8 data[2 * 4 + 1]; padding[sizeof(TypeTest) - 4]; TypeTest inner; };
+                ConstantTest constantTest @ 0x200;
+
+                std::assert(sizeof(ConstantTest) == 9 + 8 + 12, "Constant array size error");
+                std::assert(sizeof(ConstantTest) == sizeof(constantTest), "Constant type size error");
+                std::assert((1 << 4) + 0x10 * 2 == 0x30, "Constant expression error");
+
+                // Static layouts
+                bitfield StaticFlags { low : 4; high : 4; };
+                struct StaticEntry { u8 tag; StaticFlags flags; u16 value; };
+                StaticEntry staticEntries[3] @ 0x300;
+
+                std::assert(sizeof(StaticEntry) == 4, "Static layout size error");
+                std::assert(sizeof(staticEntries) == 3 * 4, "Static layout array size error");
+                std::assert(addressof(staticEntries[1].flags) == 0x305, "Static layout bitfield offset error");
+                std::assert(addressof(staticEntries[2].value) == 0x30A, "Static layout member offset error");
+                std::assert(staticEntries[2].tag == std::mem::read_unsigned(0x308, 1, 0), "Static layout value error");
+
+                fn constantCondition() {
+                    if (sizeof(TypeTest) > 100) {
+                        std::assert(false, "Constant condition error");
+                    } else {
+                        return 1;
+                    }
+
+                    return 0;
+                };
+
+                std::assert(constantCondition() == 1, "Constant condition error");
 
                 // Properties
                 std::assert(100 + 200 == 200 + 100, "+ operator commutativity error");
@@ -67,6 +99,34 @@ namespace pl::test {
 
                 std::assert(10 * (20 + 30) == 10 * 20 + 10 * 30, "* operator distributivity error");
                 std::assert(10F / (20F + 30F) != 10F / 20F + 10F / 30F, "/ operator distributivity error");
+
+                // Variables
+                fn checksum(u32 count) {
+                    u32 sum = 0;
+                    u32 i = 0;
+                    while (i < count) {
+                        sum = (sum + i * 3) & 0xFF;
+                        i = i + 1;
+                    }
+                    return sum;
+                };
+
+                std::assert(checksum(100) == 0x02, "Loop with variables error");
+
+                fn mixedTypes() {
+                    s8 negative = -2;
+                    u8 positive = 3;
+                    bool flag = true;
+
+                    std::assert(negative * 2 == -4, "Signed variable error");
+                    std::assert(negative + positive == 1, "Mixed sign variable error");
+                    std::assert((negative >> 1) == -1, "Signed variable shift error");
+                    std::assert((flag && positive > 2) ? positive == 3 : false, "Boolean variable error");
+                    std::assert(!(false && negative / 0 == 0), "&& operator short circuit error");
+                    std::assert(true || negative / 0 == 0, "|| operator short circuit error");
+                };
+
+                mixedTypes();
             )";
         }
     };
@@ -0,0 +1,90 @@
+#pragma once
+
+#include "test_pattern.hpp"
+
+#include <pl/pattern_language.hpp>
+
+#include <array>
+#include <future>
+
+namespace pl::test {
+
+    class TestPatternParallelExecution : public TestPattern {
+    public:
+        TestPatternParallelExecution(core::Evaluator *evaluator) : TestPattern(evaluator, "ParallelExecution") {
+        }
+        ~TestPatternParallelExecution() override = default;
+
+        [[nodiscard]] std::string getSourceCode() const override {
+            return R"(
+                enum Kind : u8 {
+                    A, B, C
+                };
+
+                bitfield Flags {
+                    low  : 4;
+                    high : 4;
+                };
+
+                struct Wrapper<T> {
+                    T value;
+                };
+
+                struct Entry {
+                    Kind kind;
+                    Flags flags;
+                    Wrapper<u16> wrapped;
+                    u8 data[flags.low];
+                };
+
+                Entry entries[16] @ 0x00;
+                Wrapper<Entry> wrapped @ 0x100;
+            )";
+        }
+
+        [[nodiscard]] bool runChecks(const std::vector<std::shared_ptr<ptrn::Pattern>> &patterns) const override {
+            // Compiling on the runtime of the test would replace the patterns that are being checked
+            auto compiler = this->m_runtime->cloneRuntime();
+            const auto compiledPattern = compiler.compile(this->getSourceCode());
+            if (!compiledPattern.has_value())
+                return false;
+
+            // One runtime per thread, all of them executing the same compiled pattern at the same time
+            std::array<std::optional<PatternLanguage>, RuntimeCount> runtimes;
+            for (auto &runtime : runtimes)
+                runtime.emplace(this->m_runtime->cloneRuntime());
+
+            std::array<std::future<int>, RuntimeCount> results;
+            for (size_t i = 0; i < RuntimeCount; i += 1) {
+                results[i] = std::async(std::launch::async, [&runtime = *runtimes[i], &compiledPattern] {
+                    return runtime.execute(*compiledPattern);
+                });
+            }
+
+            bool succeeded = true;
+            for (auto &result : results)
+                succeeded = result.get() == 0 && succeeded;
+
+            if (!succeeded)
+                return false;
+
+            // Every runtime has to produce the same tree as running the pattern on its own
+            for (const auto &runtime : runtimes) {
+                const auto &runtimePatterns = runtime->getPatterns();
+                if (runtimePatterns.size() != patterns.size())
+                    return false;
+
+                for (size_t i = 0; i < patterns.size(); i += 1) {
+                    if (*runtimePatterns[i] != *patterns[i])
+                        return false;
+                }
+            }
+
+            return true;
+        }
+
+    private:
+        constexpr static size_t RuntimeCount = 8;
+    };
+
+}
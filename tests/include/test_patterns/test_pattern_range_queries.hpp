@@ -0,0 +1,82 @@
+#pragma once
+
+#include "test_pattern.hpp"
+
+#include <pl/pattern_language.hpp>
+
+#include <algorithm>
+
+namespace pl::test {
+
+    class TestPatternRangeQueries : public TestPattern {
+    public:
+        TestPatternRangeQueries(core::Evaluator *evaluator) : TestPattern(evaluator, "RangeQueries") {
+        }
+        ~TestPatternRangeQueries() override = default;
+
+        [[nodiscard]] std::string getSourceCode() const override {
+            return R"(
+                struct Point {
+                    u8 x;
+                    u8 y [[color("FF0000")]];
+                };
+
+                Point points[4] @ 0x40;
+                u16 value @ 0x50 [[color("00FF00")]];
+            )";
+        }
+
+        [[nodiscard]] bool runChecks(const std::vector<std::shared_ptr<ptrn::Pattern>> &patterns) const override {
+            const auto value = std::ranges::find_if(patterns, [](const auto &pattern) { return pattern->getVariableName() == "value"; });
+            if (value == patterns.end())
+                return false;
+
+            // Static array entries are expanded arithmetically, one span per member of every entry
+            const auto spans = this->m_runtime->getPatternsInRange(0x40, 0x51);
+            if (spans.size() != 4 * 2 + 1)
+                return false;
+
+            for (u64 i = 0; i < 8; i += 1) {
+                if (spans[i].start != 0x40 + i || spans[i].end != 0x40 + i)
+                    return false;
+                if (spans[i].pattern->getVariableName() != (i % 2 == 0 ? "x" : "y"))
+                    return false;
+            }
+
+            if (spans.back().start != 0x50 || spans.back().end != 0x51 || spans.back().pattern != value->get())
+                return false;
+
+            // Only entries overlapping the range are visited
+            if (const auto partial = this->m_runtime->getPatternsInRange(0x43, 0x44); partial.size() != 2 || partial[0].start != 0x43 || partial[1].start != 0x44)
+                return false;
+
+            if (!this->m_runtime->getPatternsInRange(0x44, 0x43).empty())
+                return false;
+
+            // Color runs cover the whole range and agree with the per address queries
+            const u64 start = 0x3E, end = 0x52;
+            const auto runs = this->m_runtime->getColorsInRange(start, end);
+            if (runs.empty() || runs.front().start != start || runs.back().end != end)
+                return false;
+
+            for (size_t i = 1; i < runs.size(); i += 1) {
+                if (runs[i].start != runs[i - 1].end + 1 || runs[i].colors == runs[i - 1].colors)
+                    return false;
+            }
+
+            for (u64 address = start; address <= end; address += 1) {
+                const auto run = std::ranges::find_if(runs, [&](const auto &run) { return run.start <= address && address <= run.end; });
+                if (run == runs.end() || run->colors != this->m_runtime->getColorsAtAddress(address))
+                    return false;
+            }
+
+            // Neighbouring addresses with the same colors are merged into a single run
+            const auto valueRun = std::ranges::find_if(runs, [](const auto &run) { return run.start == 0x50; });
+            if (valueRun == runs.end() || valueRun->end != 0x51 || valueRun->colors.size() != 1)
+                return false;
+
+            return true;
+        }
+    };
+
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "test_pattern.hpp"
+
+namespace pl::test {
+
+    class TestPatternScalarRValues : public TestPattern {
+    public:
+        TestPatternScalarRValues(core::Evaluator *evaluator) : TestPattern(evaluator, "ScalarRValues") {
+        }
+        ~TestPatternScalarRValues() override = default;
+
+        [[nodiscard]] std::string getSourceCode() const override {
+            return R"(
+                fn twice(u8 value) {
+                    return value * 2;
+                };
+
+                bitfield Flags {
+                    low  : 4;
+                    high : 4;
+                };
+
+                struct Header {
+                    u8 first;
+                    be u16 big;
+                    s8 negative;
+                    Flags flags;
+                    u8 transformed [[transform("twice")]];
+
+                    std::assert(big == std::mem::read_unsigned(0x01, 2, 1), "Member value error");
+                    std::assert(flags.low == (std::mem::read_unsigned(0x04, 1, 0) & 0x0F), "Bitfield field value error");
+                };
+
+                struct Record {
+                    Header header;
+                    u8 first;
+
+                    std::assert(first == std::mem::read_unsigned(0x06, 1, 0), "Local member value error");
+                    if (header.flags.high == (std::mem::read_unsigned(0x04, 1, 0) >> 4))
+                        u8 matched;
+                };
+
+                Record record @ 0x00;
+
+                std::assert(record.header.first == std::mem::read_unsigned(0x00, 1, 0), "Nested member value error");
+                std::assert(record.header.negative == std::mem::read_signed(0x03, 1, 0), "Signed member value error");
+                std::assert(record.header.transformed == std::mem::read_unsigned(0x05, 1, 0) * 2, "Transformed member value error");
+                std::assert(sizeof(record) == 8, "Conditional member error");
+            )";
+        }
+    };
+
+}
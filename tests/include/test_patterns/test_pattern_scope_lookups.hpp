@@ -0,0 +1,63 @@
+#pragma once
+
+#include "test_pattern.hpp"
+
+namespace pl::test {
+
+    class TestPatternScopeLookups : public TestPattern {
+    public:
+        TestPatternScopeLookups(core::Evaluator *evaluator) : TestPattern(evaluator, "ScopeLookups") {
+        }
+        ~TestPatternScopeLookups() override = default;
+
+        [[nodiscard]] std::string getSourceCode() const override {
+            return R"(
+                u32 value = 1;
+                u32 global = 10;
+
+                fn shadowed(u32 value) {
+                    std::assert(value == 2, "Parameter doesn't shadow global variable");
+                    std::assert(global == 10, "Global variable not found from function");
+
+                    // Variables declared after the first lookup get indexed as well
+                    u32 first = value;
+                    u32 second = first + 1;
+                    return second;
+                };
+
+                struct Inner {
+                    u8 value;
+                    std::assert(value == std::mem::read_unsigned(0x01, 1, 0), "Inner member doesn't shadow outer member");
+                };
+
+                struct Outer {
+                    u8 value;
+                    Inner inner;
+                    std::assert(value == std::mem::read_unsigned(0x00, 1, 0), "Member doesn't shadow global variable");
+                    std::assert(inner.value == std::mem::read_unsigned(0x01, 1, 0), "Nested member lookup error");
+                };
+
+                struct Rollback {
+                    try {
+                        u8 a = 1;
+                        u8 b = a + missing;
+                    } catch {
+                        // Variables of the failed try block are gone and the name can be used again
+                        u8 a = 2;
+                        std::assert(a == 2, "Variable lookup after try rollback error");
+                    }
+                };
+
+                std::assert(shadowed(2) == 3, "Function lookup error");
+                std::assert(value == 1, "Global variable changed by shadowing parameter");
+
+                Outer outer @ 0x00;
+                Rollback rollback @ 0x10;
+
+                std::assert(value == 1, "Global variable changed by shadowing member");
+                std::assert(rollback.a == 2, "Try rollback error");
+            )";
+        }
+    };
+
+}
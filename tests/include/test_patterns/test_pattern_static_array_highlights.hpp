@@ -0,0 +1,79 @@
+#pragma once
+
+#include "test_pattern.hpp"
+
+#include <pl/pattern_language.hpp>
+#include <pl/patterns/pattern_array_static.hpp>
+
+namespace pl::test {
+
+    class TestPatternStaticArrayHighlights : public TestPattern {
+    public:
+        TestPatternStaticArrayHighlights(core::Evaluator *evaluator) : TestPattern(evaluator, "StaticArrayHighlights") {
+        }
+        ~TestPatternStaticArrayHighlights() override = default;
+
+        [[nodiscard]] std::string getSourceCode() const override {
+            return R"(
+                struct Point {
+                    u8 x;
+                    u8 y;
+                };
+
+                Point points[16] @ 0x40;
+                u8 bytes[8] @ 0x80;
+            )";
+        }
+
+        [[nodiscard]] bool runChecks(const std::vector<std::shared_ptr<ptrn::Pattern>> &patterns) const override {
+            ptrn::PatternArrayStatic *points = nullptr, *bytes = nullptr;
+            for (const auto &pattern : patterns) {
+                if (pattern->getVariableName() == "points")
+                    points = ptrn::pattern_cast<ptrn::PatternArrayStatic>(pattern.get());
+                else if (pattern->getVariableName() == "bytes")
+                    bytes = ptrn::pattern_cast<ptrn::PatternArrayStatic>(pattern.get());
+            }
+
+            if (points == nullptr || bytes == nullptr)
+                return false;
+
+            // Entries aren't expanded into highlighted children, the array stands for all of them
+            if (const auto children = points->getHighlightChildren(); children.size() != 1 || children.front().first != 0x40 || children.front().second != points)
+                return false;
+
+            // Children still list every member of every entry
+            if (const auto children = points->getChildren(); children.size() != 32)
+                return false;
+            else {
+                for (u64 i = 0; i < children.size(); i++) {
+                    if (children[i].first != 0x40 + i || children[i].second->getVariableName() != (i % 2 == 0 ? "x" : "y"))
+                        return false;
+                }
+            }
+
+            for (const u64 index : { 0, 5, 15 }) {
+                const auto address = 0x40 + index * 2 + 1;
+
+                // The highlight template gets moved to the entry that's being looked at
+                const auto result = this->m_runtime->getPatternsAtAddress(address);
+                if (result.size() != 1 || result.front()->getVariableName() != "y" || result.front()->getOffset() != address)
+                    return false;
+
+                const auto entry = dynamic_cast<IIterable*>(points->getEntry(index).get());
+                if (entry == nullptr || result.front()->getValue().toUnsigned() != entry->getEntry(1)->getValue().toUnsigned())
+                    return false;
+            }
+
+            // Addresses past the last entry don't resolve to any of them
+            if (!this->m_runtime->getPatternsAtAddress(0x60).empty())
+                return false;
+
+            // Arrays of builtin types resolve to their single entry template as well
+            if (const auto result = this->m_runtime->getPatternsAtAddress(0x83); result.size() != 1 || result.front() == bytes || result.front()->getOffset() != 0x83)
+                return false;
+
+            return true;
+        }
+    };
+
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <map>
+#include <string>
+
+#include <pl/helpers/types.hpp>
+
+#define UNIT_TEST(name) (pl::test::UnitTest *)new pl::test::UnitTest##name()
+
+namespace pl::test {
+
+    // Tests of parts of the library that don't need a pattern to be run by the test runtime
+    class UnitTest {
+    public:
+        explicit UnitTest(const std::string &name) {
+            UnitTest::s_tests.insert({ name, this });
+        }
+
+        virtual ~UnitTest() = default;
+
+        [[nodiscard]] virtual bool run() const = 0;
+
+        [[nodiscard]] static auto &getTests() {
+            return UnitTest::s_tests;
+        }
+
+    private:
+        static inline std::map<std::string, UnitTest *> s_tests;
+    };
+
+}
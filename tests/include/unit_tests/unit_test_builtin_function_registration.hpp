@@ -0,0 +1,47 @@
+#pragma once
+
+#include "unit_test.hpp"
+
+#include <pl/pattern_language.hpp>
+
+#include <array>
+#include <span>
+
+namespace pl::test {
+
+    class UnitTestBuiltinFunctionRegistration : public UnitTest {
+    public:
+        UnitTestBuiltinFunctionRegistration() : UnitTest("BuiltinFunctionRegistration") {
+        }
+        ~UnitTestBuiltinFunctionRegistration() override = default;
+
+        [[nodiscard]] bool run() const override {
+            std::array<u8, 0x10> data = { };
+            u128 reported = 0;
+
+            pl::PatternLanguage runtime;
+            runtime.setDataSource(0x00, std::span<const u8>(data));
+            runtime.addFunction({ "test" }, "report", api::FunctionParameterCount::exactly(1), [&](core::Evaluator *, auto params) -> std::optional<core::Token::Literal> {
+                reported = params[0].toUnsigned();
+                return std::nullopt;
+            });
+            runtime.addFunction({ "test" }, "first", api::FunctionParameterCount::none(), [](core::Evaluator *, auto) -> std::optional<core::Token::Literal> {
+                return u128(1);
+            });
+
+            if (runtime.executeString("test::report(test::first());") != 0 || reported != 1)
+                return false;
+
+            // Builtin functions stay registered between runs, functions added in between get registered on the next one
+            runtime.addFunction({ "test" }, "second", api::FunctionParameterCount::none(), [](core::Evaluator *, auto) -> std::optional<core::Token::Literal> {
+                return u128(2);
+            });
+
+            if (runtime.executeString("test::report(test::first() + test::second());") != 0 || reported != 3)
+                return false;
+
+            return true;
+        }
+    };
+
+}
@@ -0,0 +1,104 @@
+#pragma once
+
+#include "unit_test.hpp"
+
+#include <pl/pattern_language.hpp>
+#include <pl/patterns/pattern_array_dynamic.hpp>
+
+#include <array>
+#include <span>
+
+namespace pl::test {
+
+    class UnitTestCompactArrays : public UnitTest {
+    public:
+        UnitTestCompactArrays() : UnitTest("CompactArrays") {
+        }
+        ~UnitTestCompactArrays() override = default;
+
+        [[nodiscard]] bool run() const override {
+            constexpr static auto Source = R"(
+                #pragma lazy_entry_limit 1
+
+                struct Pair {
+                    u8 first;
+                    u8 second;
+                };
+
+                Pair pairs[8] @ 0x00 [[compact]];
+
+                std::core::set_pattern_comment(pairs[3], "third");
+                std::core::set_pattern_color(pairs[5], 0x00FF00FF);
+
+                struct Tagged {
+                    u8 value;
+                    if (value == 1)
+                        std::core::set_pattern_comment(this, "one");
+                };
+
+                struct Outer {
+                    Tagged tagged;
+                };
+
+                Tagged tagged[8] @ 0x10 [[compact]];
+                Outer outer[8] @ 0x18 [[compact]];
+            )";
+
+            std::array<u8, 0x20> data = { };
+            for (size_t i = 0; i < data.size(); i += 1)
+                data[i] = u8(i % 3);
+
+            pl::PatternLanguage runtime;
+            runtime.setDataSource(0x00, std::span<const u8>(data));
+
+            if (runtime.executeString(Source) != 0)
+                return false;
+
+            const auto &results = runtime.getPatterns();
+            const auto getArray = [&](const std::string &name) -> std::shared_ptr<ptrn::PatternArrayDynamic> {
+                for (const auto &pattern : results) {
+                    if (pattern->getVariableName() == name)
+                        return std::dynamic_pointer_cast<ptrn::PatternArrayDynamic>(pattern);
+                }
+
+                return nullptr;
+            };
+
+            // Changes made to entries of compact arrays have to stay around after other entries were accessed
+            auto pairs = getArray("pairs");
+            if (pairs == nullptr || !pairs->isLazy())
+                return false;
+
+            const auto third = pairs->getEntry(3);
+            for (u64 i = 0; i < pairs->getEntryCount(); i++)
+                (void)pairs->getEntry(i);
+
+            if (pairs->getEntry(3) != third || third->getComment() != "third")
+                return false;
+            if (!pairs->getEntry(5)->hasOverriddenColor() || pairs->getEntry(5)->getColor() != 0x00FF00FF)
+                return false;
+            if (pairs->getEntry(4)->hasOverriddenColor() || !pairs->getEntry(4)->getComment().empty())
+                return false;
+
+            // Entries that differ in anything but their offset, even in one of their members, have to be stored one by one
+            for (const auto &[name, offset, nested] : { std::tuple { "tagged", 0x10, false }, std::tuple { "outer", 0x18, true } }) {
+                auto array = getArray(name);
+                if (array == nullptr || array->isLazy())
+                    return false;
+
+                for (u64 i = 0; i < array->getEntryCount(); i++) {
+                    auto entry = array->getEntry(i);
+                    if (nested)
+                        entry = dynamic_cast<ptrn::IIterable*>(entry.get())->getEntry(0);
+
+                    const auto expectedComment = data[offset + i] == 1 ? "one" : "";
+                    if (entry->getComment() != expectedComment)
+                        return false;
+                }
+            }
+
+            return true;
+        }
+    };
+
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "unit_test.hpp"
+
+#include <pl/pattern_language.hpp>
+
+#include <numeric>
+#include <span>
+
+namespace pl::test {
+
+    class UnitTestFlattenedPatternsInvalidation : public UnitTest {
+    public:
+        UnitTestFlattenedPatternsInvalidation() : UnitTest("FlattenedPatternsInvalidation") {
+        }
+        ~UnitTestFlattenedPatternsInvalidation() override = default;
+
+        // Every run replaces the trees of the previous one
+        [[nodiscard]] bool run() const override {
+            std::vector<u8> data(0x100);
+            std::iota(data.begin(), data.end(), 0x00);
+
+            pl::PatternLanguage runtime;
+            runtime.setDataSource(0x00, std::span<const u8>(data));
+
+            if (runtime.executeString("u32 first @ 0x10;") != 0)
+                return false;
+
+            if (const auto result = runtime.getPatternsAtAddress(0x12); result.size() != 1 || result.front()->getVariableName() != "first")
+                return false;
+
+            if (runtime.executeString("u8 second @ 0x40;") != 0)
+                return false;
+
+            if (!runtime.getPatternsAtAddress(0x12).empty())
+                return false;
+            if (const auto result = runtime.getPatternsAtAddress(0x40); result.size() != 1 || result.front()->getVariableName() != "second")
+                return false;
+
+            runtime.reset();
+            if (runtime.arePatternsFlattened() || !runtime.getPatternsAtAddress(0x40).empty())
+                return false;
+
+            return true;
+        }
+    };
+
+}
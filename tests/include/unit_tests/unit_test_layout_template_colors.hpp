@@ -0,0 +1,98 @@
+#pragma once
+
+#include "unit_test.hpp"
+
+#include <pl/pattern_language.hpp>
+#include <pl/core/evaluator.hpp>
+
+#include <array>
+#include <span>
+
+namespace pl::test {
+
+    class UnitTestLayoutTemplateColors : public UnitTest {
+    public:
+        UnitTestLayoutTemplateColors() : UnitTest("LayoutTemplateColors") {
+        }
+        ~UnitTestLayoutTemplateColors() override = default;
+
+        [[nodiscard]] bool run() const override {
+            constexpr static auto Source = R"(
+                enum Kind : u8 { A, B, C };
+
+                bitfield Flags {
+                    low  : 4;
+                    high : 4;
+                };
+
+                struct Inner {
+                    u16 x;
+                    char name[4];
+                    Kind kind;
+                };
+
+                struct Colored {
+                    u8 a;
+                    u8 b;
+                } [[single_color]];
+
+                struct Entry {
+                    u8 tag;
+                    Inner inner;
+                    Inner pair[2];
+                    padding[2];
+                    Flags flags;
+                    u32 value [[color("FF0000")]];
+                    Colored colored;
+                };
+
+                Entry first @ 0x00;
+                u8 between @ 0x40;
+                Entry second @ 0x41;
+                Inner inner @ 0x80;
+                Kind kind @ 0x90;
+                Entry third @ 0xA0;
+                Flags flags @ 0xE0;
+                Colored colored @ 0xE1;
+            )";
+
+            std::array<u8, 0x100> data = { };
+            for (size_t i = 0; i < data.size(); i += 1)
+                data[i] = u8(i % 3);
+
+            const auto getColors = [&](bool useLayoutTemplates) -> std::optional<std::vector<u32>> {
+                pl::PatternLanguage runtime;
+                runtime.setDataSource(0x00, std::span<const u8>(data));
+
+                // Breakpoints stop types from being instantiated from their template. This one is never hit
+                if (!useLayoutTemplates)
+                    runtime.getInternals().evaluator->addBreakpoint(0xFFFF'FFFF);
+
+                if (runtime.executeString(Source) != 0)
+                    return std::nullopt;
+
+                std::vector<u32> colors;
+                for (const auto &pattern : runtime.getPatterns())
+                    collectColors(pattern, colors);
+
+                return colors;
+            };
+
+            const auto withTemplates = getColors(true);
+            const auto withoutTemplates = getColors(false);
+
+            return withTemplates.has_value() && withoutTemplates.has_value() && *withTemplates == *withoutTemplates;
+        }
+
+    private:
+        static void collectColors(const std::shared_ptr<ptrn::Pattern> &pattern, std::vector<u32> &colors) {
+            colors.push_back(pattern->getColor());
+
+            if (auto iterable = dynamic_cast<ptrn::IIterable*>(pattern.get()); iterable != nullptr) {
+                for (const auto &entry : iterable->getEntries())
+                    collectColors(entry, colors);
+            }
+        }
+    };
+
+}
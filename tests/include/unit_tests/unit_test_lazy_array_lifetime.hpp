@@ -0,0 +1,114 @@
+#pragma once
+
+#include "unit_test.hpp"
+
+#include <pl/pattern_language.hpp>
+#include <pl/patterns/pattern_array_dynamic.hpp>
+
+#include <array>
+#include <span>
+
+namespace pl::test {
+
+    class UnitTestLazyArrayLifetime : public UnitTest {
+    public:
+        UnitTestLazyArrayLifetime() : UnitTest("LazyArrayLifetime") {
+        }
+        ~UnitTestLazyArrayLifetime() override = default;
+
+        [[nodiscard]] bool run() const override {
+            constexpr static auto Source = R"(
+                #pragma lazy_entry_limit 1
+
+                struct Record {
+                    u8 length;
+                    u8 data[length + parent.extra];
+                };
+
+                struct File {
+                    u8 extra;
+                    Record records[4] [[lazy]];
+                };
+
+                File file @ 0x00;
+            )";
+
+            constexpr static std::array<u8, 0x10> Data = {
+                0x01,
+                0x02, 0xAA, 0xBB, 0xCC,
+                0x00, 0xDD,
+                0x01, 0xEE, 0xFF,
+                0x03, 0x11, 0x22, 0x33, 0x44
+            };
+
+            pl::PatternLanguage runtime;
+            runtime.setDataSource(0x00, std::span<const u8>(Data));
+
+            if (runtime.executeString(Source) != 0)
+                return false;
+
+            // Holds on to the top-level pattern the same way a user of the runtime would
+            const auto results = runtime.getPatterns();
+            if (results.size() != 1)
+                return false;
+
+            auto file = dynamic_cast<ptrn::IIterable*>(results.front().get());
+            if (file == nullptr || file->getEntryCount() != 2)
+                return false;
+
+            auto records = std::dynamic_pointer_cast<ptrn::PatternArrayDynamic>(file->getEntry(1));
+            if (records == nullptr || !records->isLazy())
+                return false;
+
+            // Entries are created again after the run ended, and still have to see the struct they're part of
+            if (!checkRecords(*records))
+                return false;
+
+            // The next run replaces the state entries are created from. Only the entry that is still loaded stays, the others fail cleanly
+            if (runtime.executeString("u8 value @ 0x00;") != 0)
+                return false;
+
+            const auto lastIndex = records->getEntryCount() - 1;
+            if (records->getEntry(lastIndex)->getPatternKind() != ptrn::PatternKind::Struct)
+                return false;
+
+            for (u64 i = 0; i < lastIndex; i++) {
+                if (records->getEntry(i)->getPatternKind() != ptrn::PatternKind::Error)
+                    return false;
+            }
+
+            return true;
+        }
+
+    private:
+        [[nodiscard]] static bool checkRecords(const ptrn::PatternArrayDynamic &records) {
+            constexpr static std::array<std::pair<u64, size_t>, 4> Expected = {{
+                { 0x01, 3 },
+                { 0x05, 1 },
+                { 0x07, 2 },
+                { 0x0A, 4 }
+            }};
+
+            if (records.getEntryCount() != Expected.size())
+                return false;
+
+            // Going through the entries twice makes sure evicted entries get recreated the same way
+            for (u32 pass = 0; pass < 2; pass++) {
+                for (u64 i = 0; i < Expected.size(); i++) {
+                    const auto &[offset, dataSize] = Expected[i];
+
+                    auto entry = records.getEntry(i);
+                    if (entry->getPatternKind() != ptrn::PatternKind::Struct || entry->getOffset() != offset)
+                        return false;
+
+                    auto record = dynamic_cast<ptrn::IIterable*>(entry.get());
+                    if (record == nullptr || record->getEntryCount() != 2 || record->getEntry(1)->getSize() != dataSize)
+                        return false;
+                }
+            }
+
+            return true;
+        }
+    };
+
+}
@@ -0,0 +1,97 @@
+#pragma once
+
+#include "unit_test.hpp"
+
+#include <pl/pattern_language.hpp>
+#include <pl/helpers/page_cache.hpp>
+
+#include <array>
+#include <cstring>
+#include <numeric>
+
+namespace pl::test {
+
+    class UnitTestPageCache : public UnitTest {
+    public:
+        UnitTestPageCache() : UnitTest("PageCache") {
+        }
+        ~UnitTestPageCache() override = default;
+
+        [[nodiscard]] bool run() const override {
+            std::vector<u8> data(0x100);
+            std::iota(data.begin(), data.end(), 0x00);
+
+            return checkCache(data) && checkRuntime(data);
+        }
+
+    private:
+        [[nodiscard]] static bool checkCache(const std::vector<u8> &data) {
+            u32 readerCalls = 0;
+            const auto reader = [&](u64 address, u8 *buffer, size_t size) {
+                readerCalls += 1;
+                std::memcpy(buffer, data.data() + address, size);
+            };
+
+            hlp::PageCache cache;
+            cache.configure(0x10, 2);
+
+            std::array<u8, 4> buffer = { };
+            const auto read = [&](u64 address, size_t size, u64 dataEnd = 0x100) {
+                cache.read(address, buffer.data(), size, 0x00, dataEnd, reader);
+                return std::memcmp(buffer.data(), data.data() + address, size) == 0;
+            };
+
+            const auto expect = [&](u64 hits, u64 misses, u32 calls) {
+                const auto &statistics = cache.getStatistics();
+                return statistics.hits == hits && statistics.misses == misses && readerCalls == calls;
+            };
+
+            // The first read of a page misses, following reads of the same page hit
+            if (!read(0x05, 4) || !expect(0, 1, 1)) return false;
+            if (!read(0x08, 4) || !expect(1, 1, 1)) return false;
+
+            // Reads crossing a page boundary touch both pages
+            if (!read(0x0E, 4) || !expect(2, 2, 2)) return false;
+
+            // Loading a third page evicts the least recently used one, which is page 0x00
+            if (!read(0x25, 1) || !expect(2, 3, 3)) return false;
+            if (!read(0x10, 1) || !expect(3, 3, 3)) return false;
+            if (!read(0x00, 1) || !expect(3, 4, 4)) return false;
+
+            // Invalidated pages are read again
+            cache.invalidate(0x12, 1);
+            if (!read(0x10, 1) || !expect(3, 5, 5)) return false;
+
+            // Reads reaching past the end of the data bypass the cache
+            if (!read(0xF0, 4, 0xF2) || !expect(3, 5, 6)) return false;
+
+            // Pages never reach past the end of the data
+            if (!read(0xF4, 4, 0xF8) || !expect(3, 6, 7)) return false;
+
+            // A disabled cache forwards every read
+            cache.configure(0x10, 0);
+            if (!read(0x05, 4) || !read(0x05, 4) || !expect(3, 6, 9)) return false;
+
+            return true;
+        }
+
+        [[nodiscard]] static bool checkRuntime(const std::vector<u8> &data) {
+            u32 readerCalls = 0;
+
+            pl::PatternLanguage runtime;
+            runtime.setDataSource(0x00, data.size(), [&](u64 address, u8 *buffer, size_t size) {
+                readerCalls += 1;
+                std::memcpy(buffer, data.data() + address, size);
+            });
+            runtime.setDataCache(0x40, 4);
+
+            if (runtime.executeString("u32 a @ 0x00; u32 b @ 0x04; u32 c @ 0x08; u32 sum = a + b + c;") != 0)
+                return false;
+
+            // All small reads are served from a single page
+            const auto &statistics = runtime.getDataCacheStatistics();
+            return statistics.misses == 1 && statistics.hits > 0 && readerCalls == 1;
+        }
+    };
+
+}
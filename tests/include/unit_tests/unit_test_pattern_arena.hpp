@@ -0,0 +1,60 @@
+#pragma once
+
+#include "unit_test.hpp"
+
+#include <pl/pattern_language.hpp>
+#include <pl/core/evaluator.hpp>
+
+#include <array>
+#include <span>
+#include <thread>
+
+namespace pl::test {
+
+    class UnitTestPatternArena : public UnitTest {
+    public:
+        UnitTestPatternArena() : UnitTest("PatternArena") {
+        }
+        ~UnitTestPatternArena() override = default;
+
+        [[nodiscard]] bool run() const override {
+            constexpr static auto Source = R"(
+                struct Entry {
+                    u8 tag;
+                    u16 value;
+                };
+
+                Entry entries[4] @ 0x00;
+            )";
+
+            std::array<u8, 0x10> data = { };
+
+            pl::PatternLanguage runtime;
+            runtime.setDataSource(0x00, std::span<const u8>(data));
+
+            const auto &statistics = runtime.getInternals().evaluator->getPatternArena().getStatistics();
+
+            // Patterns of the run live in the evaluator's arena until they're destroyed
+            if (runtime.executeString(Source) != 0 || statistics.liveAllocations == 0)
+                return false;
+
+            // Memory stays around as long as the host holds on to patterns of an earlier run
+            auto patterns = runtime.getPatterns();
+            const auto releases = statistics.releases.load();
+
+            if (runtime.executeString(Source) != 0 || statistics.releases != releases)
+                return false;
+
+            // The last references may go away on another thread
+            std::thread([patterns = std::move(patterns)]() mutable {
+                patterns.clear();
+            }).join();
+
+            if (runtime.executeString(Source) != 0 || statistics.releases != releases + 1)
+                return false;
+
+            return statistics.liveAllocations > 0;
+        }
+    };
+
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "unit_test.hpp"
+
+#include <pl/patterns/pattern_array_dynamic.hpp>
+#include <pl/patterns/pattern_array_static.hpp>
+#include <pl/patterns/pattern_bitfield.hpp>
+#include <pl/patterns/pattern_boolean.hpp>
+#include <pl/patterns/pattern_character.hpp>
+#include <pl/patterns/pattern_enum.hpp>
+#include <pl/patterns/pattern_error.hpp>
+#include <pl/patterns/pattern_float.hpp>
+#include <pl/patterns/pattern_padding.hpp>
+#include <pl/patterns/pattern_pointer.hpp>
+#include <pl/patterns/pattern_signed.hpp>
+#include <pl/patterns/pattern_string.hpp>
+#include <pl/patterns/pattern_struct.hpp>
+#include <pl/patterns/pattern_union.hpp>
+#include <pl/patterns/pattern_unsigned.hpp>
+#include <pl/patterns/pattern_wide_character.hpp>
+#include <pl/patterns/pattern_wide_string.hpp>
+
+#include <algorithm>
+#include <array>
+#include <utility>
+
+namespace pl::test {
+
+    class UnitTestPatternSizes : public UnitTest {
+    public:
+        UnitTestPatternSizes() : UnitTest("PatternSizes") {
+        }
+        ~UnitTestPatternSizes() override = default;
+
+        // Every pattern in a tree pays for its class, make sure none of them grows unnoticed
+        [[nodiscard]] bool run() const override {
+            constexpr static std::array<std::pair<size_t, size_t>, 23> Sizes = {{
+                { sizeof(ptrn::Pattern),                     120 },
+                { sizeof(ptrn::PatternArrayDynamic),         168 },
+                { sizeof(ptrn::PatternArrayStatic),          176 },
+                { sizeof(ptrn::PatternBitfield),             208 },
+                { sizeof(ptrn::PatternBitfieldArray),        224 },
+                { sizeof(ptrn::PatternBitfieldField),        128 },
+                { sizeof(ptrn::PatternBitfieldFieldSigned),  128 },
+                { sizeof(ptrn::PatternBitfieldFieldBoolean), 128 },
+                { sizeof(ptrn::PatternBitfieldFieldEnum),    176 },
+                { sizeof(ptrn::PatternBoolean),              120 },
+                { sizeof(ptrn::PatternCharacter),            120 },
+                { sizeof(ptrn::PatternEnum),                 168 },
+                { sizeof(ptrn::PatternError),                152 },
+                { sizeof(ptrn::PatternFloat),                120 },
+                { sizeof(ptrn::PatternPadding),              120 },
+                { sizeof(ptrn::PatternPointer),              192 },
+                { sizeof(ptrn::PatternSigned),               120 },
+                { sizeof(ptrn::PatternString),               128 },
+                { sizeof(ptrn::PatternStruct),               184 },
+                { sizeof(ptrn::PatternUnion),                184 },
+                { sizeof(ptrn::PatternUnsigned),             120 },
+                { sizeof(ptrn::PatternWideCharacter),        120 },
+                { sizeof(ptrn::PatternWideString),           128 },
+            }};
+
+            return std::ranges::all_of(Sizes, [](const auto &entry) {
+                const auto &[size, maxSize] = entry;
+                return size <= maxSize;
+            });
+        }
+    };
+
+}
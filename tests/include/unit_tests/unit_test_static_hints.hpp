@@ -0,0 +1,130 @@
+#pragma once
+
+#include "unit_test.hpp"
+
+#include <pl/pattern_language.hpp>
+
+#include <algorithm>
+#include <array>
+#include <span>
+
+namespace pl::test {
+
+    class UnitTestStaticHints : public UnitTest {
+    public:
+        UnitTestStaticHints() : UnitTest("StaticHints") {
+        }
+        ~UnitTestStaticHints() override = default;
+
+        [[nodiscard]] bool run() const override {
+            constexpr static auto Source = R"(
+                // Layouts that depend on the data
+                struct Sized {
+                    u8 count;
+                    u8 data[count];
+                } [[static]];
+
+                struct Conditional {
+                    u8 kind;
+                    if (kind == 1)
+                        u16 extra;
+                } [[static]];
+
+                struct Placed {
+                    u8 offset;
+                    u8 placed @ $ + offset;
+                } [[static]];
+
+                struct Nested {
+                    u8 header;
+                    Sized sized;
+                } [[static]];
+
+                // Layouts the optimizer doesn't compute but that don't depend on the data either
+                union Either {
+                    u8 a;
+                    u16 b;
+                } [[static]];
+
+                struct WithPointer {
+                    u8 *pointer : u8;
+                } [[static]];
+
+                struct Base {
+                    u8 a;
+                };
+
+                struct Derived : Base {
+                    u8 b;
+                } [[static]];
+
+                struct Attributed {
+                    u8 a [[no_unique_address]];
+                    u8 b;
+                } [[static]];
+
+                struct Folded {
+                    if (sizeof(u8) == 1)
+                        u8 a;
+                    else
+                        u16 b;
+                } [[static]];
+
+                u8 value @ 0x00;
+            )";
+
+            std::array<u8, 0x10> data = { };
+
+            // Warnings have to show up on both ways of running a pattern
+            for (const bool compiled : { false, true }) {
+                std::vector<std::string> warnings;
+
+                pl::PatternLanguage runtime;
+                runtime.setDataSource(0x00, std::span<const u8>(data));
+                runtime.setLogCallback([&](core::LogConsole::Level level, const std::string &message) {
+                    if (level == core::LogConsole::Level::Warning)
+                        warnings.push_back(message);
+                });
+
+                if (compiled) {
+                    if (!runtime.compile(Source).has_value())
+                        return false;
+                } else {
+                    if (runtime.executeString(Source) != 0)
+                        return false;
+                }
+
+                if (!checkWarnings(warnings))
+                    return false;
+            }
+
+            return true;
+        }
+
+    private:
+        [[nodiscard]] static bool checkWarnings(const std::vector<std::string> &warnings) {
+            const auto hasWarning = [&](std::string_view typeName, std::string_view construct) {
+                return std::ranges::any_of(warnings, [&](const std::string &warning) {
+                    return warning.contains(fmt::format("Type '{}'", typeName)) && warning.contains(construct);
+                });
+            };
+
+            if (!hasWarning("Sized", "the size of array 'data'"))
+                return false;
+            if (!hasWarning("Conditional", "the conditional"))
+                return false;
+            if (!hasWarning("Placed", "the placement of 'placed'"))
+                return false;
+            if (!hasWarning("Nested", "the size of array 'data'"))
+                return false;
+
+            for (const auto typeName : { "Either", "WithPointer", "Derived", "Attributed", "Folded" }) {
+                if (hasWarning(typeName, "[[static]]"))
+                    return false;
+            }
+
+            return true;
+        }
+    };
+
+}
@@ -12,6 +12,7 @@
 #include <pl/patterns/pattern.hpp>
 
 #include "test_patterns/test_pattern.hpp"
+#include "unit_tests/unit_test.hpp"
 
 #include <fmt/args.h>
 
@@ -19,7 +20,7 @@
 using namespace pl;
 using namespace pl::test;
 
-int runTests(int argc, char **argv) {
+int runTests(int argc, char **argv, bool precompile) {
     auto &testPatterns = TestPattern::getTests();
 
     // Check if a test to run has been provided
@@ -38,12 +39,9 @@ int runTests(int argc, char **argv) {
     const auto &currTest = testPatterns[testName];
     bool failing         = currTest->getMode() == Mode::Failing;
 
-    wolv::io::File testData("test_data", wolv::io::File::Mode::Read);
+    const auto testData = wolv::io::File("test_data", wolv::io::File::Mode::Read).readVector();
     pl::PatternLanguage runtime;
-    runtime.setDataSource(0x00, testData.getSize(), [&testData](u64 offset, u8 *buffer, u64 size) {
-        testData.seek(offset);
-        testData.readBuffer(buffer, size);
-    });
+    runtime.setDataSource(0x00, testData);
 
 
     runtime.addFunction({ "std" }, "assert", api::FunctionParameterCount::exactly(2), [](core::Evaluator *ctx, auto params) -> std::optional<core::Token::Literal> {
@@ -109,8 +107,19 @@ int runTests(int argc, char **argv) {
     test->m_runtime = &runtime;
     test->setup();
 
+    // Alternate between compiling the pattern once up front and running it straight from source
+    std::optional<CompiledPattern> compiledPattern;
+    if (precompile)
+        compiledPattern = runtime.compile(test->getSourceCode());
+
     for (size_t i = 0; i < test->repeatTimes(); i++) {
-        auto result = runtime.executeString(test->getSourceCode());
+        int result;
+        if (!precompile)
+            result = runtime.executeString(test->getSourceCode());
+        else if (compiledPattern.has_value())
+            result = runtime.execute(*compiledPattern);
+        else
+            result = EXIT_FAILURE;
 
         // Check if compilation succeeded
         if (result != 0) {
@@ -161,11 +170,40 @@ int runTests(int argc, char **argv) {
     return EXIT_SUCCESS;
 }
 
+int runUnitTest(const UnitTest &test) {
+    if (!test.run()) {
+        fmt::print("Unit test failed!\n");
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+
 int main(int argc, char **argv) {
     int result = EXIT_SUCCESS;
 
+    ON_SCOPE_EXIT {
+        for (auto &[key, value] : UnitTest::getTests())
+            delete value;
+    };
+
+    // Unit tests set up everything they need on their own, so they only run once
+    if (argc == 2) {
+        auto &unitTests = UnitTest::getTests();
+        if (auto it = unitTests.find(argv[1]); it != unitTests.end()) {
+            result = runUnitTest(*it->second);
+
+            if (result == EXIT_SUCCESS)
+                fmt::print("Success!\n");
+            else
+                fmt::print("Failed!\n");
+
+            return result;
+        }
+    }
+
     for (u32 i = 0; i < 16; i++) { // Test several times with the same PatternLanguage runtime instance (see static declaration in runTests()) to check if the runtime resets properly
-        result = runTests(argc, argv);
+        result = runTests(argc, argv, i % 2 == 1);
         if (result != EXIT_SUCCESS)
             break;
     }
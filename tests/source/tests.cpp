@@ -31,6 +31,26 @@
 #include "test_patterns/test_pattern_typenameof.hpp"
 #include "test_patterns/test_pattern_custom_builtin_type.hpp"
 #include "test_patterns/test_pattern_using.hpp"
+#include "test_patterns/test_pattern_lazy_arrays.hpp"
+#include "test_patterns/test_pattern_scalar_rvalues.hpp"
+#include "test_patterns/test_pattern_flattened_patterns.hpp"
+#include "test_patterns/test_pattern_static_array_highlights.hpp"
+#include "test_patterns/test_pattern_range_queries.hpp"
+#include "test_patterns/test_pattern_heap_checkpoints.hpp"
+#include "test_patterns/test_pattern_scope_lookups.hpp"
+#include "test_patterns/test_pattern_call_targets.hpp"
+#include "test_patterns/test_pattern_constant_conditions.hpp"
+#include "test_patterns/test_pattern_parallel_execution.hpp"
+
+#include "unit_tests/unit_test_page_cache.hpp"
+#include "unit_tests/unit_test_builtin_function_registration.hpp"
+#include "unit_tests/unit_test_static_hints.hpp"
+#include "unit_tests/unit_test_layout_template_colors.hpp"
+#include "unit_tests/unit_test_lazy_array_lifetime.hpp"
+#include "unit_tests/unit_test_compact_arrays.hpp"
+#include "unit_tests/unit_test_flattened_patterns_invalidation.hpp"
+#include "unit_tests/unit_test_pattern_sizes.hpp"
+#include "unit_tests/unit_test_pattern_arena.hpp"
 
 static pl::core::Evaluator s_evaluator;
 
@@ -67,4 +87,26 @@ std::array Tests = {
     TEST(TypeNameOf),
     TEST(CustomBuiltinType),
     TEST(Using),
+    TEST(LazyArrays),
+    TEST(ScalarRValues),
+    TEST(FlattenedPatterns),
+    TEST(StaticArrayHighlights),
+    TEST(RangeQueries),
+    TEST(HeapCheckpoints),
+    TEST(ScopeLookups),
+    TEST(CallTargets),
+    TEST(ConstantConditions),
+    TEST(ParallelExecution),
+};
+
+std::array UnitTests = {
+    UNIT_TEST(PageCache),
+    UNIT_TEST(BuiltinFunctionRegistration),
+    UNIT_TEST(StaticHints),
+    UNIT_TEST(LayoutTemplateColors),
+    UNIT_TEST(LazyArrayLifetime),
+    UNIT_TEST(CompactArrays),
+    UNIT_TEST(FlattenedPatternsInvalidation),
+    UNIT_TEST(PatternSizes),
+    UNIT_TEST(PatternArena),
 };